@@ -25,4 +25,8 @@ ifeq (${TRUSTED_BOARD_BOOT},1)
 BL1_SOURCES		+=	bl1/bl1_fwu.c
 endif
 
+ifeq (${ENABLE_BOOT_INSTRUMENTATION},1)
+BL1_SOURCES		+=	lib/boot_instr/boot_instr.c
+endif
+
 BL1_LINKERFILE		:=	bl1/bl1.ld.S
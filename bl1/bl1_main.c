@@ -16,6 +16,7 @@
 #include <common/debug.h>
 #include <drivers/auth/auth_mod.h>
 #include <drivers/console.h>
+#include <lib/boot_instr.h>
 #include <lib/cpus/errata_report.h>
 #include <lib/utils.h>
 #include <plat/common/platform.h>
@@ -56,12 +57,16 @@ void bl1_calc_bl2_mem_layout(const meminfo_t *bl1_mem_layout,
  ******************************************************************************/
 void bl1_setup(void)
 {
+	BOOT_INSTR_MARK_ENTRY();
+
 	/* Perform early platform-specific setup */
 	bl1_early_platform_setup();
 
 	/* Perform late platform-specific setup */
 	bl1_plat_arch_setup();
 
+	BOOT_INSTR_SETUP(BOOT_INSTR_BL1_ENTRY);
+
 #if CTX_INCLUDE_PAUTH_REGS
 	/*
 	 * Assert that the ARMv8.3-PAuth registers are present or an access
@@ -149,7 +154,11 @@ void bl1_main(void)
 
 	bl1_prepare_next_image(image_id);
 
+	/* Print the messages recorded in the log ring before handing off */
+	tf_log_ring_flush();
 	console_flush();
+
+	BOOT_INSTR_CAPTURE(BOOT_INSTR_BL1_EXIT);
 }
 
 /*******************************************************************************
@@ -15,6 +15,10 @@ ifeq (${ARCH},aarch64)
 BL2_SOURCES		+=	common/aarch64/early_exceptions.S
 endif
 
+ifeq (${ENABLE_BOOT_INSTRUMENTATION},1)
+BL2_SOURCES		+=	lib/boot_instr/boot_instr.c
+endif
+
 ifeq (${BL2_AT_EL3},0)
 BL2_SOURCES		+=	bl2/${ARCH}/bl2_entrypoint.S
 BL2_LINKERFILE		:=	bl2/bl2.ld.S
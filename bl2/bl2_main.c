@@ -17,6 +17,7 @@
 #if MEASURED_BOOT
 #include <drivers/measured_boot/measured_boot.h>
 #endif
+#include <lib/boot_instr.h>
 #include <lib/extensions/pauth.h>
 #include <plat/common/platform.h>
 
@@ -35,12 +36,16 @@
 void bl2_setup(u_register_t arg0, u_register_t arg1, u_register_t arg2,
 	       u_register_t arg3)
 {
+	BOOT_INSTR_MARK_ENTRY();
+
 	/* Perform early platform-specific setup */
 	bl2_early_platform_setup2(arg0, arg1, arg2, arg3);
 
 	/* Perform late platform-specific setup */
 	bl2_plat_arch_setup();
 
+	BOOT_INSTR_SETUP(BOOT_INSTR_BL2_ENTRY);
+
 #if CTX_INCLUDE_PAUTH_REGS
 	/*
 	 * Assert that the ARMv8.3-PAuth registers are present or an access
@@ -57,12 +62,16 @@ void bl2_setup(u_register_t arg0, u_register_t arg1, u_register_t arg2,
 void bl2_el3_setup(u_register_t arg0, u_register_t arg1, u_register_t arg2,
 		   u_register_t arg3)
 {
+	BOOT_INSTR_MARK_ENTRY();
+
 	/* Perform early platform-specific setup */
 	bl2_el3_early_platform_setup(arg0, arg1, arg2, arg3);
 
 	/* Perform late platform-specific setup */
 	bl2_el3_plat_arch_setup();
 
+	BOOT_INSTR_SETUP(BOOT_INSTR_BL2_ENTRY);
+
 #if CTX_INCLUDE_PAUTH_REGS
 	/*
 	 * Assert that the ARMv8.3-PAuth registers are present or an access
@@ -111,6 +120,12 @@ void bl2_main(void)
 #endif /* MEASURED_BOOT */
 
 #if !BL2_AT_EL3
+	/*
+	 * Print the messages recorded in the log ring before handing off, while
+	 * the MMU is still enabled.
+	 */
+	tf_log_ring_flush();
+
 #ifndef __aarch64__
 	/*
 	 * For AArch32 state BL1 and BL2 share the MMU setup.
@@ -122,6 +137,8 @@ void bl2_main(void)
 
 	console_flush();
 
+	BOOT_INSTR_CAPTURE(BOOT_INSTR_BL2_EXIT);
+
 #if ENABLE_PAUTH
 	/*
 	 * Disable pointer authentication before running next boot image
@@ -138,8 +155,11 @@ void bl2_main(void)
 #else /* if BL2_AT_EL3 */
 	NOTICE("BL2: Booting " NEXT_IMAGE "\n");
 	print_entry_point_info(next_bl_ep_info);
+	tf_log_ring_flush();
 	console_flush();
 
+	BOOT_INSTR_CAPTURE(BOOT_INSTR_BL2_EXIT);
+
 #if ENABLE_PAUTH
 	/*
 	 * Disable pointer authentication before running next boot image
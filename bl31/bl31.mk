@@ -45,6 +45,10 @@ ifeq (${ENABLE_PMF}, 1)
 BL31_SOURCES		+=	lib/pmf/pmf_main.c
 endif
 
+ifeq (${ENABLE_BOOT_INSTRUMENTATION},1)
+BL31_SOURCES		+=	lib/boot_instr/boot_instr.c
+endif
+
 include lib/debugfs/debugfs.mk
 ifeq (${USE_DEBUGFS},1)
 	BL31_SOURCES	+= $(DEBUGFS_SRCS)
@@ -54,6 +58,10 @@ ifeq (${EL3_EXCEPTION_HANDLING},1)
 BL31_SOURCES		+=	bl31/ehf.c
 endif
 
+ifeq (${ENABLE_EL3_PROF},1)
+BL31_SOURCES		+=	lib/el3_prof/el3_prof.c
+endif
+
 ifeq (${SDEI_SUPPORT},1)
 ifeq (${EL3_EXCEPTION_HANDLING},0)
   $(error EL3_EXCEPTION_HANDLING must be 1 for SDEI support)
@@ -95,8 +103,22 @@ ifndef CRASH_REPORTING
 CRASH_REPORTING		:=	$(DEBUG)
 endif
 
+# Flag used to save the CPU state in a persistent memory region on a crash,
+# before it is reported on the console. It requires CRASH_REPORTING.
+ifndef CRASH_DUMP
+CRASH_DUMP		:=	0
+endif
+
+ifeq (${CRASH_DUMP},1)
+ifneq (${CRASH_REPORTING},1)
+        $(error "CRASH_DUMP requires CRASH_REPORTING")
+endif
+BL31_SOURCES		+=	bl31/aarch64/crash_dump.S
+endif
+
 $(eval $(call assert_booleans,\
     $(sort \
+	CRASH_DUMP \
 	CRASH_REPORTING \
 	EL3_EXCEPTION_HANDLING \
 	SDEI_SUPPORT \
@@ -104,6 +126,7 @@ $(eval $(call assert_booleans,\
 
 $(eval $(call add_defines,\
     $(sort \
+        CRASH_DUMP \
         CRASH_REPORTING \
         EL3_EXCEPTION_HANDLING \
         SDEI_SUPPORT \
@@ -16,6 +16,8 @@
 #include <common/debug.h>
 #include <common/runtime_svc.h>
 #include <drivers/console.h>
+#include <lib/boot_instr.h>
+#include <lib/el3_prof.h>
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/pmf/pmf.h>
 #include <lib/runtime_instr.h>
@@ -79,12 +81,16 @@ void __init bl31_lib_init(void)
 void bl31_setup(u_register_t arg0, u_register_t arg1, u_register_t arg2,
 		u_register_t arg3)
 {
+	BOOT_INSTR_MARK_ENTRY();
+
 	/* Perform early platform-specific setup */
 	bl31_early_platform_setup2(arg0, arg1, arg2, arg3);
 
 	/* Perform late platform-specific setup */
 	bl31_plat_arch_setup();
 
+	BOOT_INSTR_SETUP(BOOT_INSTR_BL31_ENTRY);
+
 #if CTX_INCLUDE_PAUTH_REGS
 	/*
 	 * Assert that the ARMv8.3-PAuth registers are present or an access
@@ -124,6 +130,10 @@ void bl31_main(void)
 	ehf_init();
 #endif
 
+#if ENABLE_EL3_PROF
+	el3_prof_init();
+#endif
+
 	/* Initialize the runtime services e.g. psci. */
 	INFO("BL31: Initializing runtime services\n");
 	runtime_svc_init();
@@ -138,6 +148,8 @@ void bl31_main(void)
 	 * can prepare entry into BL33 as normal.
 	 */
 
+	BOOT_INSTR_CAPTURE(BOOT_INSTR_BL31_BL32_INIT);
+
 	/*
 	 * If SPD had registered an init hook, invoke it.
 	 */
@@ -155,6 +167,11 @@ void bl31_main(void)
 	 */
 	bl31_prepare_next_image_entry();
 
+	/*
+	 * Print the messages recorded in the log ring during the cold boot.
+	 * The ones of the runtime are left for the platform to flush.
+	 */
+	tf_log_ring_flush();
 	console_flush();
 
 	/*
@@ -162,6 +179,8 @@ void bl31_main(void)
 	 * from BL31
 	 */
 	bl31_plat_runtime_setup();
+
+	BOOT_INSTR_CAPTURE(BOOT_INSTR_BL31_EXIT);
 }
 
 /*******************************************************************************
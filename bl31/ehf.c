@@ -9,17 +9,20 @@
  */
 
 #include <assert.h>
+#include <errno.h>
 #include <stdbool.h>
 
 #include <bl31/ehf.h>
 #include <bl31/interrupt_mgmt.h>
 #include <context.h>
 #include <common/debug.h>
+#include <common/runtime_svc.h>
 #include <drivers/arm/gic_common.h>
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/el3_runtime/cpu_data.h>
 #include <lib/el3_runtime/pubsub_events.h>
 #include <plat/common/platform.h>
+#include <smccc_helpers.h>
 
 /* Output EHF logs as verbose */
 #define EHF_LOG(...)	VERBOSE("EHF: " __VA_ARGS__)
@@ -50,6 +53,24 @@
 /* To be defined by the platform */
 extern const ehf_priorities_t exception_data;
 
+#if ENABLE_EHF_STAT
+/* Statistics of a priority level on a CPU */
+typedef struct ehf_pri_stat {
+	uint64_t count;		/* Number of interrupts handled */
+	uint64_t time;		/* Time spent in the handlers, in counter ticks */
+} ehf_pri_stat_t;
+
+/*
+ * Statistics of the priority levels of each CPU. They are only updated by the
+ * CPU they belong to, and are kept in separate cache lines.
+ */
+typedef struct ehf_pe_stat {
+	ehf_pri_stat_t pri[EHF_MAX_PRIORITIES];
+} __aligned(CACHE_WRITEBACK_GRANULE) ehf_pe_stat_t;
+
+static ehf_pe_stat_t ehf_stat[PLATFORM_CORE_COUNT];
+#endif
+
 /* Translate priority to the index in the priority array */
 static unsigned int pri_to_idx(unsigned int priority)
 {
@@ -440,12 +461,23 @@ static uint64_t ehf_el3_interrupt_handler(uint32_t id, uint32_t flags,
 		panic();
 	}
 
+#if ENABLE_EHF_STAT
+	ehf_pri_stat_t *stat = &ehf_stat[plat_my_core_pos()].pri[idx];
+	uint64_t start = read_cntpct_el0();
+#endif
+
 	/*
 	 * Call registered handler. Pass the raw interrupt value to registered
 	 * handlers.
 	 */
 	ret = handler(intr_raw, flags, handle, cookie);
 
+#if ENABLE_EHF_STAT
+	/* The time of the handlers of preempting priorities is included */
+	stat->count++;
+	stat->time += read_cntpct_el0() - start;
+#endif
+
 	return (uint64_t) ret;
 }
 
@@ -522,5 +554,43 @@ void ehf_register_priority_handler(unsigned int pri, ehf_handler_t handler)
 	EHF_LOG("register pri=0x%x handler=%p\n", pri, handler);
 }
 
+#if ENABLE_EHF_STAT
+/*
+ * This function handles the EHF SMC calls, which return the statistics of a
+ * priority level on a CPU.
+ */
+uintptr_t ehf_smc_handler(unsigned int smc_fid,
+		u_register_t x1,
+		u_register_t x2,
+		u_register_t x3,
+		u_register_t x4,
+		void *cookie,
+		void *handle,
+		u_register_t flags)
+{
+	const ehf_pri_stat_t *stat;
+	unsigned int idx;
+	int cpu_idx;
+
+	if (smc_fid != EHF_SMC_GET_STAT_64) {
+		WARN("Unimplemented EHF Call: 0x%x\n", smc_fid);
+		SMC_RET1(handle, SMC_UNK);
+	}
+
+	cpu_idx = plat_core_pos_by_mpidr(x1);
+	if (cpu_idx < 0)
+		SMC_RET1(handle, -EINVAL);
+
+	/* The priority must be one of the platform EL3 priority levels */
+	idx = EHF_PRI_TO_IDX(x2, exception_data.pri_bits);
+	if (!IS_PRI_SECURE(x2) || (idx >= exception_data.num_priorities) ||
+			!IS_IDX_VALID(idx) || (IDX_TO_PRI(idx) != x2))
+		SMC_RET1(handle, -EINVAL);
+
+	stat = &ehf_stat[cpu_idx].pri[idx];
+	SMC_RET3(handle, SMC_OK, stat->count, stat->time);
+}
+#endif /* ENABLE_EHF_STAT */
+
 SUBSCRIBE_TO_EVENT(cm_entering_normal_world, ehf_entering_normal_world);
 SUBSCRIBE_TO_EVENT(cm_exited_normal_world, ehf_exited_normal_world);
@@ -15,6 +15,7 @@
 #include <common/debug.h>
 #include <drivers/auth/auth_mod.h>
 #include <drivers/io/io_storage.h>
+#include <lib/boot_instr.h>
 #include <lib/utils.h>
 #include <lib/xlat_tables/xlat_tables_defs.h>
 #include <plat/common/platform.h>
@@ -239,10 +240,14 @@ int load_auth_image(unsigned int image_id, image_info_t *image_data)
 {
 	int err;
 
+	BOOT_INSTR_CAPTURE(BOOT_INSTR_IMAGE_LOAD_START(image_id));
+
 	do {
 		err = load_auth_image_internal(image_id, image_data);
 	} while ((err != 0) && (plat_try_next_boot_source() != 0));
 
+	BOOT_INSTR_CAPTURE(BOOT_INSTR_IMAGE_LOAD_END(image_id));
+
 	return err;
 }
 
@@ -8,8 +8,15 @@
 #include <errno.h>
 #include <string.h>
 
+#include <platform_def.h>
+
+#include <arch_helpers.h>
 #include <common/debug.h>
 #include <common/runtime_svc.h>
+#include <lib/el3_runtime/cpu_data.h>
+#include <lib/pmf/pmf.h>
+#include <lib/runtime_instr.h>
+#include <plat/common/platform.h>
 
 /*******************************************************************************
  * The 'rt_svc_descs' array holds the runtime service descriptors exported by
@@ -25,6 +32,155 @@ uint8_t rt_svc_descs_indices[MAX_RT_SVCS];
 #define RT_SVC_DECS_NUM		((RT_SVC_DESCS_END - RT_SVC_DESCS_START)\
 					/ sizeof(rt_svc_desc_t))
 
+#if SMC_FID_FAST_PATH
+/*******************************************************************************
+ * The 'rt_svc_fid_table' hash table holds the SMC function ids exported by
+ * services in the 'rt_svc_fid_descs' linker section whose owning service has
+ * been successfully initialised. When an SMC arrives, its function id is first
+ * looked up in this table and, on a match, the SMC is handed to the registered
+ * handler without going through 'rt_svc_descs_indices' and the decoding done
+ * by the top level handler of the owning service. A lookup starts at the slot
+ * given by rt_svc_fid_hash() and stops at the first empty slot, so that SMCs
+ * which aren't in the table usually cost a single extra load.
+ ******************************************************************************/
+rt_svc_fid_entry_t rt_svc_fid_table[RT_SVC_FID_TABLE_SIZE];
+
+#define RT_SVC_FID_DESCS_NUM	((RT_SVC_FID_DESCS_END - \
+					RT_SVC_FID_DESCS_START) \
+					/ sizeof(rt_svc_fid_desc_t))
+#endif
+
+#if ENABLE_SMC_STAT
+/* Number of function ids of which statistics are kept, on each CPU */
+#ifndef PLAT_SMC_STAT_FIDS
+#define PLAT_SMC_STAT_FIDS	U(16)
+#endif
+
+CASSERT(IS_POWER_OF_TWO(PLAT_SMC_STAT_FIDS), assert_smc_stat_fids_pow2);
+
+/* Statistics of a set of SMCs on a CPU */
+typedef struct smc_stat {
+	uint64_t count;		/* Number of calls */
+	uint64_t time;		/* Time spent in the handlers, in counter ticks */
+} smc_stat_t;
+
+/* Statistics of a function id. A slot is in use once its count is not 0. */
+typedef struct smc_fid_stat {
+	uint32_t smc_fid;
+	smc_stat_t stat;
+} smc_fid_stat_t;
+
+/*
+ * SMC statistics of each CPU, by owning entity number and by function id.
+ * They are only updated by the CPU they belong to, and are kept in separate
+ * cache lines.
+ */
+typedef struct smc_pe_stat {
+	smc_stat_t oen[OEN_LIMIT];
+	smc_fid_stat_t fid[PLAT_SMC_STAT_FIDS];
+	uint64_t fid_dropped;	/* Calls not recorded by function id */
+} __aligned(CACHE_WRITEBACK_GRANULE) smc_pe_stat_t;
+
+static smc_pe_stat_t smc_stat[PLATFORM_CORE_COUNT];
+
+/*******************************************************************************
+ * Account an SMC whose handler was called at time `start` and has returned.
+ * Function ids are kept in a small open addressing table, so that the hot
+ * ones are recorded whichever service they belong to.
+ ******************************************************************************/
+void smc_stat_record(uint32_t smc_fid, uint64_t start)
+{
+	smc_pe_stat_t *pe_stat = &smc_stat[plat_my_core_pos()];
+	uint64_t time = read_cntpct_el0() - start;
+	smc_fid_stat_t *fid_stat;
+	unsigned int i, slot;
+
+	pe_stat->oen[GET_SMC_OEN(smc_fid)].count++;
+	pe_stat->oen[GET_SMC_OEN(smc_fid)].time += time;
+
+	slot = (smc_fid ^ (smc_fid >> 16)) & (PLAT_SMC_STAT_FIDS - 1U);
+	for (i = 0U; i < PLAT_SMC_STAT_FIDS; i++) {
+		fid_stat = &pe_stat->fid[slot];
+		if (fid_stat->stat.count == 0U)
+			fid_stat->smc_fid = smc_fid;
+
+		if (fid_stat->smc_fid == smc_fid) {
+			fid_stat->stat.count++;
+			fid_stat->stat.time += time;
+			return;
+		}
+
+		slot = (slot + 1U) & (PLAT_SMC_STAT_FIDS - 1U);
+	}
+
+	pe_stat->fid_dropped++;
+}
+
+/*******************************************************************************
+ * This function handles the SMC statistics calls, which return the statistics
+ * of an owning entity number or of a function id slot on a CPU.
+ ******************************************************************************/
+uintptr_t smc_stat_smc_handler(unsigned int smc_fid,
+		u_register_t x1,
+		u_register_t x2,
+		u_register_t x3,
+		u_register_t x4,
+		void *cookie,
+		void *handle,
+		u_register_t flags)
+{
+	const smc_pe_stat_t *pe_stat;
+	const smc_fid_stat_t *fid_stat;
+	int cpu_idx;
+
+	cpu_idx = plat_core_pos_by_mpidr(x1);
+	if (cpu_idx < 0)
+		SMC_RET1(handle, -EINVAL);
+
+	pe_stat = &smc_stat[cpu_idx];
+
+	switch (smc_fid) {
+	case SMC_STAT_SMC_GET_OEN_64:
+		if (x2 >= OEN_LIMIT)
+			SMC_RET1(handle, -EINVAL);
+
+		SMC_RET3(handle, SMC_OK, pe_stat->oen[x2].count,
+			 pe_stat->oen[x2].time);
+
+	case SMC_STAT_SMC_GET_FID_64:
+		if (x2 >= PLAT_SMC_STAT_FIDS)
+			SMC_RET1(handle, -EINVAL);
+
+		fid_stat = &pe_stat->fid[x2];
+		SMC_RET5(handle, SMC_OK, fid_stat->smc_fid,
+			 fid_stat->stat.count, fid_stat->stat.time,
+			 pe_stat->fid_dropped);
+
+	default:
+		WARN("Unimplemented SMC statistics Call: 0x%x\n", smc_fid);
+		SMC_RET1(handle, SMC_UNK);
+	}
+}
+#endif /* ENABLE_SMC_STAT */
+
+/*******************************************************************************
+ * Function to look up the handler registered for the smc_fid in the SMC
+ * function id fast path table. Returns NULL if there is none.
+ ******************************************************************************/
+static rt_svc_handle_t get_rt_svc_fid_handler(uint32_t smc_fid)
+{
+#if SMC_FID_FAST_PATH
+	unsigned int i;
+
+	for (i = rt_svc_fid_hash(smc_fid); rt_svc_fid_table[i].smc_fid != 0U;
+	     i = (i + 1U) & (RT_SVC_FID_TABLE_SIZE - 1U)) {
+		if ((uint32_t)rt_svc_fid_table[i].smc_fid == smc_fid)
+			return rt_svc_fid_table[i].handle;
+	}
+#endif
+	return NULL;
+}
+
 /*******************************************************************************
  * Function to invoke the registered `handle` corresponding to the smc_fid in
  * AArch32 mode.
@@ -38,21 +194,53 @@ uintptr_t handle_runtime_svc(uint32_t smc_fid,
 	unsigned int index;
 	unsigned int idx;
 	const rt_svc_desc_t *rt_svc_descs;
+	rt_svc_handle_t handler;
+	uintptr_t ret;
 
 	assert(handle != NULL);
-	idx = get_unique_oen_from_smc_fid(smc_fid);
-	assert(idx < MAX_RT_SVCS);
 
-	index = rt_svc_descs_indices[idx];
-	if (index >= RT_SVC_DECS_NUM)
-		SMC_RET1(handle, SMC_UNK);
+	handler = get_rt_svc_fid_handler(smc_fid);
+	if (handler == NULL) {
+		idx = get_unique_oen_from_smc_fid(smc_fid);
+		assert(idx < MAX_RT_SVCS);
 
-	rt_svc_descs = (rt_svc_desc_t *) RT_SVC_DESCS_START;
+		index = rt_svc_descs_indices[idx];
+		if (index >= RT_SVC_DECS_NUM)
+			SMC_RET1(handle, SMC_UNK);
+
+		rt_svc_descs = (rt_svc_desc_t *) RT_SVC_DESCS_START;
+		handler = rt_svc_descs[index].handle;
+	}
 
 	get_smc_params_from_ctx(handle, x1, x2, x3, x4);
 
-	return rt_svc_descs[index].handle(smc_fid, x1, x2, x3, x4, cookie,
-						handle, flags);
+#if ENABLE_SMC_STAT
+	uint64_t start = read_cntpct_el0();
+#endif
+
+	ret = handler(smc_fid, x1, x2, x3, x4, cookie, handle, flags);
+
+#if ENABLE_SMC_STAT
+	smc_stat_record(smc_fid, start);
+#endif
+
+#if ENABLE_SMC_INSTRUMENTATION
+	/*
+	 * Record the time at which the SMC entered the monitor and the time
+	 * at which its handler returned, so that the round-trip cost of the
+	 * dispatch can be retrieved through PMF.
+	 */
+	PMF_WRITE_TIMESTAMP(rt_instr_svc,
+	    RT_INSTR_ENTER_SMC,
+	    PMF_NO_CACHE_MAINT,
+	    get_cpu_data(cpu_data_pmf_ts[CPU_DATA_PMF_TS0_IDX]));
+
+	PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+	    RT_INSTR_EXIT_SMC,
+	    PMF_NO_CACHE_MAINT);
+#endif
+
+	return ret;
 }
 
 /*******************************************************************************
@@ -80,6 +268,63 @@ static int32_t validate_rt_svc_desc(const rt_svc_desc_t *desc)
 	return 0;
 }
 
+#if SMC_FID_FAST_PATH
+/*******************************************************************************
+ * This function populates the SMC function id fast path table from the
+ * descriptors exported by services. A function id is only added if the runtime
+ * service owning it has been registered, so that an SMC can never reach the
+ * handler of a service whose initialisation failed.
+ ******************************************************************************/
+static void __init rt_svc_fid_init(void)
+{
+	unsigned int i, j;
+	unsigned int idx;
+	unsigned int count = 0U;
+	const rt_svc_fid_desc_t *fid_descs;
+
+	fid_descs = (const rt_svc_fid_desc_t *) RT_SVC_FID_DESCS_START;
+
+	for (i = 0U; i < RT_SVC_FID_DESCS_NUM; i++) {
+		const rt_svc_fid_desc_t *desc = &fid_descs[i];
+
+		/* Only fast calls, so that a function id of 0 is an empty slot */
+		if ((desc->handle == NULL) ||
+		    (GET_SMC_TYPE(desc->smc_fid) != SMC_TYPE_FAST)) {
+			ERROR("Invalid SMC fast path descriptor %s\n",
+				desc->name);
+			panic();
+		}
+
+		idx = get_unique_oen_from_smc_fid(desc->smc_fid);
+		if (rt_svc_descs_indices[idx] >= RT_SVC_DECS_NUM) {
+			VERBOSE("SMC fast path: skipping %s, no service\n",
+				desc->name);
+			continue;
+		}
+
+		if (count == MAX_RT_SVC_FIDS) {
+			ERROR("Too many SMC fast path function ids\n");
+			panic();
+		}
+
+		for (j = rt_svc_fid_hash(desc->smc_fid);
+		     rt_svc_fid_table[j].smc_fid != 0U;
+		     j = (j + 1U) & (RT_SVC_FID_TABLE_SIZE - 1U)) {
+			if ((uint32_t)rt_svc_fid_table[j].smc_fid ==
+			    desc->smc_fid) {
+				ERROR("Duplicate SMC fast path function id 0x%x\n",
+					desc->smc_fid);
+				panic();
+			}
+		}
+
+		rt_svc_fid_table[j].smc_fid = desc->smc_fid;
+		rt_svc_fid_table[j].handle = desc->handle;
+		count++;
+	}
+}
+#endif
+
 /*******************************************************************************
  * This function calls the initialisation routine in the descriptor exported by
  * a runtime service. Once a descriptor has been validated, its start & end
@@ -151,4 +396,8 @@ void __init runtime_svc_init(void)
 		for (; start_idx <= end_idx; start_idx++)
 			rt_svc_descs_indices[start_idx] = index;
 	}
+
+#if SMC_FID_FAST_PATH
+	rt_svc_fid_init();
+#endif
 }
@@ -1,19 +1,353 @@
 /*
- * Copyright (c) 2017-2019, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2020, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <stdarg.h>
 #include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
+#include <platform_def.h>
+
+#include <arch_helpers.h>
 #include <common/debug.h>
+#include <lib/cassert.h>
+#include <lib/spinlock.h>
+#include <lib/utils_def.h>
 #include <plat/common/platform.h>
 
 /* Set the default maximum log level to the `LOG_LEVEL` build flag */
 static unsigned int max_log_level = LOG_LEVEL;
 
+#if ENABLE_LOG_RING
+/* Number of records of the log ring. It must be a power of 2. */
+#ifndef PLAT_LOG_RING_ENTRIES
+#define PLAT_LOG_RING_ENTRIES	64U
+#endif
+
+CASSERT(IS_POWER_OF_TWO(PLAT_LOG_RING_ENTRIES), assert_log_ring_entries_pow2);
+
+/* Maximum number of arguments recorded for a message */
+#define LOG_RING_MAX_ARGS	5U
+
+/* Size of the buffer holding the string arguments of a record */
+#define LOG_RING_STR_SIZE	32U
+
+/*
+ * Binary log record. The format string is the one of the image, past the log
+ * marker, so that it can be resolved from the ELF file of the image when the
+ * log ring is extracted from memory. Arguments are recorded as 64-bit values.
+ * String arguments may not outlive the call, so they are copied one after the
+ * other in `strs`, truncated if needed, and their argument is their offset in
+ * `strs`.
+ */
+typedef struct tf_log_rec {
+	const char *fmt;
+	unsigned long long ts;
+	unsigned int level;
+	unsigned int nargs;
+	unsigned long long args[LOG_RING_MAX_ARGS];
+	char strs[LOG_RING_STR_SIZE];
+} tf_log_rec_t;
+
+/*
+ * The log ring and its indices are global for the ring to be located from the
+ * symbols of the image. `tf_log_ring_head` is the sequence number of the next
+ * record to be written, and `tf_log_ring_tail` the one of the next record to
+ * be flushed; the record of a sequence number is at the index of the sequence
+ * number modulo the size of the ring.
+ */
+tf_log_rec_t tf_log_ring[PLAT_LOG_RING_ENTRIES];
+unsigned int tf_log_ring_head;
+unsigned int tf_log_ring_tail;
+
+/* Size of the log ring, for the crash dump code to copy it */
+const unsigned int tf_log_ring_size = sizeof(tf_log_ring);
+
+/* Number of records overwritten before they were flushed */
+static unsigned int tf_log_ring_lost;
+
+/*
+ * Only the images running on several cpus need a lock. Others don't
+ * necessarily include the spinlock implementation. The lock can't be relied
+ * upon before the data cache is enabled, when only the primary cpu runs, so it
+ * isn't taken then.
+ */
+#if defined(IMAGE_BL31) || defined(IMAGE_BL32)
+static spinlock_t tf_log_ring_lock;
+
+static bool log_ring_lock(void)
+{
+	if (!is_dcache_enabled())
+		return false;
+
+	spin_lock(&tf_log_ring_lock);
+	return true;
+}
+
+static void log_ring_unlock(bool locked)
+{
+	if (locked)
+		spin_unlock(&tf_log_ring_lock);
+}
+#else
+static inline bool log_ring_lock(void)
+{
+	return false;
+}
+
+static inline void log_ring_unlock(bool locked)
+{
+}
+#endif
+
+/*
+ * Skip the length and padding specifiers of the conversion at `fmt`, past the
+ * '%' character, and return the number of 'l' length specifiers found.
+ */
+static int log_ring_skip_spec(const char **fmt)
+{
+	int l_count = 0;
+
+	for (;; (*fmt)++) {
+		if (**fmt == 'l') {
+			l_count++;
+		} else if (**fmt == 'z') {
+			if (sizeof(size_t) == 8U)
+				l_count = 2;
+		} else if ((**fmt < '0') || (**fmt > '9')) {
+			return l_count;
+		}
+	}
+}
+
+/*
+ * Copy the string `str` at offset `*len` of the string buffer `strs`, truncated
+ * to fit, and return its offset. Once the buffer is full, the offset of its
+ * last null character is returned.
+ */
+static unsigned int log_ring_add_str(char *strs, unsigned int *len,
+				     const char *str)
+{
+	unsigned int off = *len;
+
+	if (off >= LOG_RING_STR_SIZE)
+		return LOG_RING_STR_SIZE - 1U;
+
+	if (str == NULL)
+		str = "(null)";
+
+	while ((*str != '\0') && (*len < (LOG_RING_STR_SIZE - 1U)))
+		strs[(*len)++] = *str++;
+	strs[(*len)++] = '\0';
+
+	return off;
+}
+
+/* Record a message in the log ring, with the arguments of its conversions */
+static void log_ring_add(unsigned int log_level, const char *fmt,
+			 va_list args)
+{
+	unsigned long long vals[LOG_RING_MAX_ARGS];
+	unsigned long long ts = read_cntpct_el0();
+	char strs[LOG_RING_STR_SIZE];
+	unsigned int strs_len = 0U;
+	unsigned int nargs = 0U;
+	const char *p = fmt;
+	tf_log_rec_t *rec;
+	bool locked;
+	int l_count;
+
+	/* Collect the arguments, with the same conversions as vprintf() */
+	while ((*p != '\0') && (nargs < LOG_RING_MAX_ARGS)) {
+		if (*p++ != '%')
+			continue;
+
+		l_count = log_ring_skip_spec(&p);
+
+		switch (*p) {
+		case 'i':
+		case 'd':
+			vals[nargs++] = (l_count > 1) ?
+				(unsigned long long)va_arg(args, long long) :
+				((l_count == 1) ?
+				(unsigned long long)va_arg(args, long) :
+				(unsigned long long)va_arg(args, int));
+			break;
+		case 'u':
+		case 'x':
+			vals[nargs++] = (l_count > 1) ?
+				va_arg(args, unsigned long long) :
+				((l_count == 1) ?
+				va_arg(args, unsigned long) :
+				va_arg(args, unsigned int));
+			break;
+		case 's':
+			vals[nargs++] = log_ring_add_str(strs, &strs_len,
+					va_arg(args, const char *));
+			break;
+		case 'p':
+			vals[nargs++] = (uintptr_t)va_arg(args, void *);
+			break;
+		default:
+			/* vprintf() stops on other conversions */
+			p = "";
+			continue;
+		}
+		p++;
+	}
+
+	locked = log_ring_lock();
+
+	rec = &tf_log_ring[tf_log_ring_head & (PLAT_LOG_RING_ENTRIES - 1U)];
+	tf_log_ring_head++;
+	if ((tf_log_ring_head - tf_log_ring_tail) > PLAT_LOG_RING_ENTRIES) {
+		tf_log_ring_tail++;
+		tf_log_ring_lost++;
+	}
+
+	rec->fmt = fmt;
+	rec->ts = ts;
+	rec->level = log_level;
+	rec->nargs = nargs;
+	while (nargs-- > 0U)
+		rec->args[nargs] = vals[nargs];
+	(void)memcpy(rec->strs, strs, strs_len);
+
+	log_ring_unlock(locked);
+}
+
+/* Print a record of the log ring */
+static void log_ring_print(const tf_log_rec_t *rec)
+{
+	const char *prefix_str = plat_log_get_prefix(rec->level);
+	const char *fmt = rec->fmt;
+	const char *spec;
+	char buf[8];
+	unsigned long long val;
+	unsigned int i = 0U;
+	size_t len;
+	int l_count;
+
+	(void)printf("%s", prefix_str);
+
+	while (*fmt != '\0') {
+		if (*fmt != '%') {
+			(void)putchar(*fmt);
+			fmt++;
+			continue;
+		}
+
+		/* Print each conversion on its own, with its recorded value */
+		spec = fmt++;
+		l_count = log_ring_skip_spec(&fmt);
+		len = (size_t)(fmt - spec) + 1U;
+		if ((*fmt == '\0') || (len >= sizeof(buf)))
+			return;
+
+		(void)memcpy(buf, spec, len);
+		buf[len] = '\0';
+
+		if (i >= rec->nargs) {
+			(void)putchar('?');
+			fmt++;
+			continue;
+		}
+		val = rec->args[i++];
+
+		switch (*fmt) {
+		case 'i':
+		case 'd':
+			if (l_count > 1)
+				(void)printf(buf, (long long)val);
+			else if (l_count == 1)
+				(void)printf(buf, (long)val);
+			else
+				(void)printf(buf, (int)val);
+			break;
+		case 'u':
+		case 'x':
+			if (l_count > 1)
+				(void)printf(buf, val);
+			else if (l_count == 1)
+				(void)printf(buf, (unsigned long)val);
+			else
+				(void)printf(buf, (unsigned int)val);
+			break;
+		case 's':
+			if (val >= LOG_RING_STR_SIZE)
+				return;
+			(void)printf(buf, &rec->strs[val]);
+			break;
+		case 'p':
+			(void)printf(buf, (void *)(uintptr_t)val);
+			break;
+		default:
+			return;
+		}
+		fmt++;
+	}
+}
+
+/*
+ * Print the records of the log ring which haven't been printed yet, oldest
+ * first, taking the lock of the ring if `use_lock` is set.
+ */
+static void log_ring_flush(bool use_lock)
+{
+	tf_log_rec_t rec;
+	unsigned int lost;
+	bool locked = false;
+
+	for (;;) {
+		if (use_lock)
+			locked = log_ring_lock();
+
+		if (tf_log_ring_tail == tf_log_ring_head) {
+			log_ring_unlock(locked);
+			break;
+		}
+
+		rec = tf_log_ring[tf_log_ring_tail &
+				  (PLAT_LOG_RING_ENTRIES - 1U)];
+		tf_log_ring_tail++;
+		lost = tf_log_ring_lost;
+		tf_log_ring_lost = 0U;
+
+		log_ring_unlock(locked);
+
+		if (lost != 0U)
+			(void)printf("(%u log messages lost)\n", lost);
+
+		log_ring_print(&rec);
+	}
+}
+
+/*
+ * Print the pending records of the log ring. The boot images call this before
+ * handing off to the next image, and platforms can call it whenever the cost
+ * of console output is acceptable.
+ */
+void tf_log_ring_flush(void)
+{
+	log_ring_flush(true);
+}
+
+/*
+ * Print the pending records of the log ring on panic. The lock of the ring
+ * isn't taken, as the panic may have happened while this cpu, or a crashed one,
+ * held it. Records written concurrently by other cpus may be printed torn.
+ */
+void tf_log_ring_panic_flush(void)
+{
+	log_ring_flush(false);
+}
+#endif /* ENABLE_LOG_RING */
+
 /*
  * The common log function which is invoked by TF-A code.
  * This function should not be directly invoked and is meant to be
@@ -25,7 +359,9 @@ void tf_log(const char *fmt, ...)
 {
 	unsigned int log_level;
 	va_list args;
+#if !ENABLE_LOG_RING
 	const char *prefix_str;
+#endif
 
 	/* We expect the LOG_MARKER_* macro as the first character */
 	log_level = fmt[0];
@@ -37,6 +373,11 @@ void tf_log(const char *fmt, ...)
 	if (log_level > max_log_level)
 		return;
 
+#if ENABLE_LOG_RING
+	va_start(args, fmt);
+	log_ring_add(log_level, fmt + 1, args);
+	va_end(args);
+#else
 	prefix_str = plat_log_get_prefix(log_level);
 
 	while (*prefix_str != '\0') {
@@ -47,6 +388,7 @@ void tf_log(const char *fmt, ...)
 	va_start(args, fmt);
 	(void)vprintf(fmt + 1, args);
 	va_end(args);
+#endif
 }
 
 /*
@@ -44,6 +44,18 @@ static bool is_sgi_ppi(unsigned int id);
 #define SAVE_GICR_REG(base, ctx, name, i)	\
 	(ctx)->gicr_##name[(i)] = gicr_read_##name((base), (i))
 
+/*
+ * Helper macro to restore a GICR set (write 1 to set) register from the context.
+ * Writing 0 to these registers has no effect, so the write is skipped when no
+ * bit is set in the saved value.
+ */
+#define RESTORE_GICR_SET_REG(base, ctx, name, i)			\
+	do {								\
+		if ((ctx)->gicr_##name[(i)] != 0U) {			\
+			RESTORE_GICR_REG(base, ctx, name, i);		\
+		}							\
+	} while (false)
+
 /* Helper macros to save and restore GICD registers to and from the context */
 #define RESTORE_GICD_REGS(base, ctx, intr_num, reg, REG)		\
 	do {								\
@@ -64,6 +76,24 @@ static bool is_sgi_ppi(unsigned int id);
 		}							\
 	} while (false)
 
+/*
+ * Helper macro to restore GICD set (write 1 to set) registers from the context.
+ * Writing 0 to these registers has no effect, so the writes are skipped for the
+ * registers in which no bit is set in the saved value. This avoids most of the
+ * writes to GICD_ISPENDR and GICD_ISACTIVER, for instance.
+ */
+#define RESTORE_GICD_SET_REGS(base, ctx, intr_num, reg, REG)		\
+	do {								\
+		for (unsigned int int_id = MIN_SPI_ID; int_id < (intr_num);\
+				int_id += (1U << REG##R_SHIFT)) {	\
+			unsigned int val = (ctx)->gicd_##reg[(int_id -	\
+					MIN_SPI_ID) >> REG##R_SHIFT];	\
+			if (val != 0U) {				\
+				gicd_write_##reg((base), int_id, val);	\
+			}						\
+		}							\
+	} while (false)
+
 #if GIC_EXT_INTID
 #define RESTORE_GICD_EREGS(base, ctx, intr_num, reg, REG)		\
 	do {								\
@@ -83,9 +113,22 @@ static bool is_sgi_ppi(unsigned int id);
 			>> REG##R_SHIFT] = gicd_read_##reg((base), int_id);\
 		}							\
 	} while (false)
+
+#define RESTORE_GICD_SET_EREGS(base, ctx, intr_num, reg, REG)		\
+	do {								\
+		for (unsigned int int_id = MIN_ESPI_ID; int_id < (intr_num);\
+				int_id += (1U << REG##R_SHIFT)) {	\
+			unsigned int val = (ctx)->gicd_##reg[(int_id -	\
+				(MIN_ESPI_ID - MIN_SPI_ID)) >> REG##R_SHIFT];\
+			if (val != 0U) {				\
+				gicd_write_##reg((base), int_id, val);	\
+			}						\
+		}							\
+	} while (false)
 #else
 #define SAVE_GICD_EREGS(base, ctx, intr_num, reg, REG)
 #define RESTORE_GICD_EREGS(base, ctx, intr_num, reg, REG)
+#define RESTORE_GICD_SET_EREGS(base, ctx, intr_num, reg, REG)
 #endif /* GIC_EXT_INTID */
 
 /*******************************************************************************
@@ -695,8 +738,8 @@ void gicv3_rdistif_init_restore(unsigned int proc_num,
 	 * 32 interrupt IDs per register
 	 */
 	for (i = 0U; i < ppi_regs_num; ++i) {
-		RESTORE_GICR_REG(gicr_base, rdist_ctx, ispendr, i);
-		RESTORE_GICR_REG(gicr_base, rdist_ctx, isactiver, i);
+		RESTORE_GICR_SET_REG(gicr_base, rdist_ctx, ispendr, i);
+		RESTORE_GICR_SET_REG(gicr_base, rdist_ctx, isactiver, i);
 	}
 
 	/*
@@ -707,7 +750,7 @@ void gicv3_rdistif_init_restore(unsigned int proc_num,
 
 	/* 32 interrupt IDs per GICR_ISENABLER register */
 	for (i = 0U; i < ppi_regs_num; ++i) {
-		RESTORE_GICR_REG(gicr_base, rdist_ctx, isenabler, i);
+		RESTORE_GICR_SET_REG(gicr_base, rdist_ctx, isenabler, i);
 	}
 
 	/*
@@ -926,22 +969,22 @@ void gicv3_distif_init_restore(const gicv3_dist_ctx_t * const dist_ctx)
 	 */
 
 	/* Restore GICD_ISENABLER for INT_IDs 32 - 1019 */
-	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, isenabler, ISENABLE);
+	RESTORE_GICD_SET_REGS(gicd_base, dist_ctx, num_ints, isenabler, ISENABLE);
 
 	/* Restore GICD_ISENABLERE for INT_IDs 4096 - 5119 */
-	RESTORE_GICD_EREGS(gicd_base, dist_ctx, num_eints, isenabler, ISENABLE);
+	RESTORE_GICD_SET_EREGS(gicd_base, dist_ctx, num_eints, isenabler, ISENABLE);
 
 	/* Restore GICD_ISPENDR for INTIDs 32 - 1019 */
-	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, ispendr, ISPEND);
+	RESTORE_GICD_SET_REGS(gicd_base, dist_ctx, num_ints, ispendr, ISPEND);
 
 	/* Restore GICD_ISPENDRE for INTIDs 4096 - 5119 */
-	RESTORE_GICD_EREGS(gicd_base, dist_ctx, num_eints, ispendr, ISPEND);
+	RESTORE_GICD_SET_EREGS(gicd_base, dist_ctx, num_eints, ispendr, ISPEND);
 
 	/* Restore GICD_ISACTIVER for INTIDs 32 - 1019 */
-	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, isactiver, ISACTIVE);
+	RESTORE_GICD_SET_REGS(gicd_base, dist_ctx, num_ints, isactiver, ISACTIVE);
 
 	/* Restore GICD_ISACTIVERE for INTIDs 4096 - 5119 */
-	RESTORE_GICD_EREGS(gicd_base, dist_ctx, num_eints, isactiver, ISACTIVE);
+	RESTORE_GICD_SET_EREGS(gicd_base, dist_ctx, num_eints, isactiver, ISACTIVE);
 
 	/* Restore the GICD_CTLR */
 	gicd_write_ctlr(gicd_base, dist_ctx->gicd_ctlr);
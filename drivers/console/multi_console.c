@@ -5,12 +5,79 @@
  */
 
 #include <assert.h>
+#include <stdbool.h>
 
+#include <arch_helpers.h>
 #include <drivers/console.h>
+#include <lib/spinlock.h>
 
 console_t *console_list;
 uint8_t console_state = CONSOLE_FLAG_BOOT;
 
+#if CONSOLE_TX_BUF_SIZE
+/*
+ * Characters output with console_putc() are accumulated in this buffer and
+ * written to the consoles a line at a time, to let the drivers fill their
+ * transmit FIFO with several characters at once.
+ */
+static char console_tx_buf[CONSOLE_TX_BUF_SIZE];
+static size_t console_tx_len;
+
+/*
+ * Only the images running on several cpus need a lock. Others don't
+ * necessarily include the spinlock implementation. The console is used before
+ * the MMU is enabled, when the exclusive accesses of the lock can't be relied
+ * upon and only the primary cpu runs, so the lock is only taken once the data
+ * cache is enabled.
+ */
+#if defined(IMAGE_BL31) || defined(IMAGE_BL32)
+static spinlock_t console_tx_lock;
+
+static bool console_tx_buf_lock(void)
+{
+	if (!is_dcache_enabled())
+		return false;
+
+	spin_lock(&console_tx_lock);
+	return true;
+}
+
+static void console_tx_buf_unlock(bool locked)
+{
+	if (locked)
+		spin_unlock(&console_tx_lock);
+}
+#else
+static inline bool console_tx_buf_lock(void)
+{
+	return false;
+}
+
+static inline void console_tx_buf_unlock(bool locked)
+{
+}
+#endif
+
+static int do_console_write(const char *buf, size_t len);
+
+/* Write the buffered characters. Must be called with the buffer lock held. */
+static int console_tx_buf_drain(void)
+{
+	int ret = 0;
+
+	if (console_tx_len != 0U) {
+		ret = do_console_write(console_tx_buf, console_tx_len);
+		console_tx_len = 0U;
+	}
+
+	return ret;
+}
+#else
+#define console_tx_buf_lock()		false
+#define console_tx_buf_unlock(locked)	(void)(locked)
+#define console_tx_buf_drain()		0
+#endif /* CONSOLE_TX_BUF_SIZE */
+
 IMPORT_SYM(console_t *, __STACKS_START__, stacks_start)
 IMPORT_SYM(console_t *, __STACKS_END__, stacks_end)
 
@@ -60,7 +127,13 @@ int console_is_registered(console_t *to_find)
 
 void console_switch_state(unsigned int new_state)
 {
+	bool locked;
+
+	/* Buffered characters belong to the consoles of the previous state */
+	locked = console_tx_buf_lock();
+	(void)console_tx_buf_drain();
 	console_state = new_state;
+	console_tx_buf_unlock(locked);
 }
 
 void console_set_scope(console_t *console, unsigned int scope)
@@ -84,8 +157,87 @@ static int do_putc(int c, console_t *console)
 	return console->putc(c, console);
 }
 
+static int do_write(const char *buf, size_t len, console_t *console)
+{
+	size_t i, start = 0U;
+	int ret;
+
+	if (console->write == NULL) {
+		for (i = 0U; i < len; i++) {
+			ret = do_putc((unsigned char)buf[i], console);
+			if (ret < 0)
+				return ret;
+		}
+		return (int)len;
+	}
+
+	if ((console->flags & CONSOLE_FLAG_TRANSLATE_CRLF) == 0U)
+		return console->write(buf, len, console);
+
+	/* Write the buffer line by line, with "\r\n" as line endings */
+	for (i = 0U; i < len; i++) {
+		if (buf[i] != '\n')
+			continue;
+
+		if (i > start) {
+			ret = console->write(&buf[start], i - start, console);
+			if (ret < 0)
+				return ret;
+		}
+
+		ret = console->write("\r\n", 2U, console);
+		if (ret < 0)
+			return ret;
+
+		start = i + 1U;
+	}
+
+	if (len > start) {
+		ret = console->write(&buf[start], len - start, console);
+		if (ret < 0)
+			return ret;
+	}
+
+	return (int)len;
+}
+
+static int do_console_write(const char *buf, size_t len)
+{
+	int err = ERROR_NO_VALID_CONSOLE;
+	console_t *console;
+
+	for (console = console_list; console != NULL; console = console->next)
+		if ((console->flags & console_state) &&
+		    ((console->putc != NULL) || (console->write != NULL))) {
+			int ret = do_write(buf, len, console);
+			if ((err == ERROR_NO_VALID_CONSOLE) || (ret < err))
+				err = ret;
+		}
+
+	return err;
+}
+
 int console_putc(int c)
 {
+#if CONSOLE_TX_BUF_SIZE
+	bool locked;
+	int ret;
+
+	locked = console_tx_buf_lock();
+
+	console_tx_buf[console_tx_len++] = (char)c;
+
+	/* Write complete lines, or the whole buffer once it is full */
+	if ((c == '\n') || (console_tx_len == CONSOLE_TX_BUF_SIZE)) {
+		ret = console_tx_buf_drain();
+		console_tx_buf_unlock(locked);
+		return (ret < 0) ? ret : c;
+	}
+
+	console_tx_buf_unlock(locked);
+
+	return c;
+#else
 	int err = ERROR_NO_VALID_CONSOLE;
 	console_t *console;
 
@@ -97,6 +249,24 @@ int console_putc(int c)
 		}
 
 	return err;
+#endif
+}
+
+int console_write(const char *buf, size_t len)
+{
+	bool locked;
+	int ret;
+
+	locked = console_tx_buf_lock();
+
+	/* Keep the order with the characters already buffered */
+	ret = console_tx_buf_drain();
+	if (ret >= 0)
+		ret = do_console_write(buf, len);
+
+	console_tx_buf_unlock(locked);
+
+	return ret;
 }
 
 int console_getc(void)
@@ -123,6 +293,11 @@ int console_flush(void)
 {
 	int err = ERROR_NO_VALID_CONSOLE;
 	console_t *console;
+	bool locked;
+
+	locked = console_tx_buf_lock();
+	(void)console_tx_buf_drain();
+	console_tx_buf_unlock(locked);
 
 	for (console = console_list; console != NULL; console = console->next)
 		if ((console->flags & console_state) && (console->flush != NULL)) {
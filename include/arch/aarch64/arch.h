@@ -188,6 +188,11 @@
 #define ID_AA64DFR0_PMS_SHIFT	U(32)
 #define ID_AA64DFR0_PMS_MASK	ULL(0xf)
 
+/* ID_AA64ISAR0_EL1 definitions */
+#define ID_AA64ISAR0_TLB_SHIFT	U(56)
+#define ID_AA64ISAR0_TLB_MASK	ULL(0xf)
+#define ID_AA64ISAR0_TLB_RANGE	ULL(0x2)
+
 /* ID_AA64ISAR1_EL1 definitions */
 #define ID_AA64ISAR1_EL1	S3_0_C0_C6_1
 #define ID_AA64ISAR1_GPI_SHIFT	U(28)
@@ -714,6 +719,30 @@
 #define TLBI_ADDR_MASK		ULL(0x00000FFFFFFFFFFF)
 #define TLBI_ADDR(x)		(((x) >> TLBI_ADDR_SHIFT) & TLBI_ADDR_MASK)
 
+/*
+ * Operand of the ARMv8.4-TLBI range instructions. The range covers
+ * (NUM + 1) << (5 * SCALE + 1) pages of the translation granule TG, starting
+ * from BaseADDR expressed in pages.
+ */
+#define TLBI_RANGE_BADDR_MASK	ULL(0x1FFFFFFFFF)
+#define TLBI_RANGE_NUM_SHIFT	U(39)
+#define TLBI_RANGE_NUM_MASK	ULL(0x1f)
+#define TLBI_RANGE_SCALE_SHIFT	U(44)
+#define TLBI_RANGE_SCALE_MASK	ULL(0x3)
+#define TLBI_RANGE_TG_SHIFT	U(46)
+#define TLBI_RANGE_TG_4K	ULL(0x1)
+#define TLBI_RANGE_TG_16K	ULL(0x2)
+#define TLBI_RANGE_TG_64K	ULL(0x3)
+#define TLBI_RANGE_PAGES(num, scale)	\
+	(((num) + 1ULL) << ((5ULL * (scale)) + 1ULL))
+#define TLBI_RANGE_MAX_PAGES	\
+	TLBI_RANGE_PAGES(TLBI_RANGE_NUM_MASK, TLBI_RANGE_SCALE_MASK)
+#define TLBI_RANGE(baddr, num, scale, tg)				\
+	(((baddr) & TLBI_RANGE_BADDR_MASK) |				\
+	 (((num) & TLBI_RANGE_NUM_MASK) << TLBI_RANGE_NUM_SHIFT) |	\
+	 (((scale) & TLBI_RANGE_SCALE_MASK) << TLBI_RANGE_SCALE_SHIFT) |\
+	 ((tg) << TLBI_RANGE_TG_SHIFT))
+
 /*******************************************************************************
  * Definitions of register offsets and fields in the CNTCTLBase Frame of the
  * system level implementation of the Generic Timer.
@@ -757,6 +786,17 @@
 #define PMCR_EL0_P_BIT		(U(1) << 1)
 #define PMCR_EL0_E_BIT		(U(1) << 0)
 
+/* PMCCFILTR_EL0 definitions */
+#define PMCCFILTR_EL0_P_BIT	(U(1) << 31)
+#define PMCCFILTR_EL0_U_BIT	(U(1) << 30)
+#define PMCCFILTR_EL0_NSK_BIT	(U(1) << 29)
+#define PMCCFILTR_EL0_NSU_BIT	(U(1) << 28)
+#define PMCCFILTR_EL0_NSH_BIT	(U(1) << 27)
+#define PMCCFILTR_EL0_M_BIT	(U(1) << 26)
+
+/* Cycle counter bit of the PMCNTEN, PMINTEN and PMOVS set/clear registers */
+#define PMU_CYCLE_CNT_BIT	(U(1) << 31)
+
 /*******************************************************************************
  * Definitions for system register interface to SVE
  ******************************************************************************/
@@ -7,13 +7,31 @@
 #ifndef EHF_H
 #define EHF_H
 
+#include <lib/utils_def.h>
+
+/*
+ * SMC function ID to retrieve the statistics of an EL3 exception priority
+ * level on a CPU, when ENABLE_EHF_STAT is set:
+ *
+ * x1: MPIDR of the CPU
+ * x2: Priority
+ *
+ * Returns the error code in x0, the number of interrupts handled in x1 and the
+ * time spent in their handlers, in system counter ticks, in x2.
+ */
+#define EHF_SMC_GET_STAT_64	U(0xC2000040)
+#define EHF_NUM_SMC_CALLS	1
+
+/* The macros below are used to identify EHF calls from the SMC function ID */
+#define EHF_FID_MASK		U(0xffe0)
+#define EHF_FID_VALUE		U(0x40)
+#define is_ehf_fid(_fid)	(((_fid) & EHF_FID_MASK) == EHF_FID_VALUE)
+
 #ifndef __ASSEMBLER__
 
 #include <cdefs.h>
 #include <stdint.h>
 
-#include <lib/utils_def.h>
-
 /* Valid priorities set bit 0 of the priority handler. */
 #define EHF_PRI_VALID_	BIT(0)
 
@@ -48,6 +66,9 @@
  */
 typedef uint32_t ehf_pri_bits_t;
 
+/* Maximum number of priority levels */
+#define EHF_MAX_PRIORITIES	(sizeof(ehf_pri_bits_t) * 8U)
+
 /*
  * Per-PE exception data. The data for each PE is kept as a per-CPU data field.
  * See cpu_data.h.
@@ -87,6 +108,17 @@ void ehf_register_priority_handler(unsigned int pri, ehf_handler_t handler);
 void ehf_allow_ns_preemption(uint64_t preempt_ret_code);
 unsigned int ehf_is_ns_preemption_allowed(void);
 
+#if ENABLE_EHF_STAT
+uintptr_t ehf_smc_handler(unsigned int smc_fid,
+		u_register_t x1,
+		u_register_t x2,
+		u_register_t x3,
+		u_register_t x4,
+		void *cookie,
+		void *handle,
+		u_register_t flags);
+#endif
+
 #endif /* __ASSEMBLER__ */
 
 #endif /* EHF_H */
@@ -39,6 +39,12 @@
 	KEEP(*(rt_svc_descs))				\
 	__RT_SVC_DESCS_END__ = .;
 
+#define RT_SVC_FID_DESCS				\
+	. = ALIGN(STRUCT_ALIGN);			\
+	__RT_SVC_FID_DESCS_START__ = .;			\
+	KEEP(*(rt_svc_fid_descs))			\
+	__RT_SVC_FID_DESCS_END__ = .;
+
 #define PMF_SVC_DESCS					\
 	. = ALIGN(STRUCT_ALIGN);			\
 	__PMF_SVC_DESCS_START__ = .;			\
@@ -82,6 +88,7 @@
 
 #define RODATA_COMMON					\
 	RT_SVC_DESCS					\
+	RT_SVC_FID_DESCS				\
 	FCONF_POPULATOR					\
 	PMF_SVC_DESCS					\
 	PARSER_LIB_DESCS				\
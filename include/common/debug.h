@@ -96,13 +96,22 @@ const char *get_el_str(unsigned int el);
 #define backtrace(x)
 #endif
 
+#if ENABLE_LOG_RING
+void tf_log_ring_flush(void);
+void tf_log_ring_panic_flush(void);
+#else
+#define tf_log_ring_flush()
+#define tf_log_ring_panic_flush()
+#endif
+
 void __dead2 do_panic(void);
 
-#define panic()				\
-	do {				\
-		backtrace(__func__);	\
-		(void)console_flush();	\
-		do_panic();		\
+#define panic()					\
+	do {					\
+		tf_log_ring_panic_flush();	\
+		backtrace(__func__);		\
+		(void)console_flush();		\
+		do_panic();			\
 	} while (false)
 
 /* Function called when stack protection check code detects a corrupted stack */
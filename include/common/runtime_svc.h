@@ -31,6 +31,31 @@
 #endif /* __aarch64__ */
 #define SIZEOF_RT_SVC_DESC	(U(1) << RT_SVC_SIZE_LOG2)
 
+/*
+ * Constants to allow the assembler access an entry of the SMC function id
+ * fast path table
+ */
+#ifdef __aarch64__
+#define RT_SVC_FID_ENTRY_SIZE_LOG2	U(4)
+#define RT_SVC_FID_ENTRY_HANDLE		U(8)
+#else
+#define RT_SVC_FID_ENTRY_SIZE_LOG2	U(3)
+#define RT_SVC_FID_ENTRY_HANDLE		U(4)
+#endif /* __aarch64__ */
+#define SIZEOF_RT_SVC_FID_ENTRY		(U(1) << RT_SVC_FID_ENTRY_SIZE_LOG2)
+
+/* Maximum number of SMC function ids that can be registered in the fast path */
+#define MAX_RT_SVC_FIDS			U(16)
+
+/*
+ * The fast path table is an open addressing hash table indexed by
+ * (smc_fid ^ (smc_fid >> RT_SVC_FID_HASH_SHIFT)). It is kept at most a quarter
+ * full, so that a lookup which misses usually stops at the first slot, and
+ * always stops at an empty slot, whose function id is 0.
+ */
+#define RT_SVC_FID_TABLE_SIZE		U(64)
+#define RT_SVC_FID_HASH_SHIFT		U(25)
+
 
 /*
  * In SMCCC 1.X, the function identifier has 6 bits for the owning entity number
@@ -39,6 +64,34 @@
  */
 #define MAX_RT_SVCS		U(128)
 
+/*
+ * SMC function IDs to retrieve the SMC statistics of a CPU, when
+ * ENABLE_SMC_STAT is set:
+ *
+ * SMC_STAT_SMC_GET_OEN_64: statistics of an owning entity number.
+ * x1: MPIDR of the CPU
+ * x2: Owning entity number
+ * Returns the error code in x0, the number of calls in x1 and the time spent
+ * in their handlers, in system counter ticks, in x2.
+ *
+ * SMC_STAT_SMC_GET_FID_64: statistics of a function ID slot.
+ * x1: MPIDR of the CPU
+ * x2: Slot index, from 0 to the first index returning -EINVAL
+ * Returns the error code in x0, the function ID in x1, the number of calls in
+ * x2, the time spent in their handlers in x3 and the number of calls which
+ * weren't recorded by function ID, because all the slots were in use, in x4.
+ * Slots which aren't in use return 0 calls.
+ */
+#define SMC_STAT_SMC_GET_OEN_64		U(0xC2000060)
+#define SMC_STAT_SMC_GET_FID_64		U(0xC2000061)
+#define SMC_STAT_NUM_SMC_CALLS		2
+
+/* The macros below are used to identify SMC statistics calls */
+#define SMC_STAT_FID_MASK		U(0xffe0)
+#define SMC_STAT_FID_VALUE		U(0x60)
+#define is_smc_stat_fid(_fid)	\
+	(((_fid) & SMC_STAT_FID_MASK) == SMC_STAT_FID_VALUE)
+
 #ifndef __ASSEMBLER__
 
 /* Prototype for runtime service initializing function */
@@ -81,6 +134,43 @@ typedef struct rt_svc_desc {
 			.handle = (_smch)				\
 		}
 
+/*
+ * Descriptor of a single SMC function id that is dispatched straight to its
+ * handler, bypassing the owning entity lookup and the decoding done by the
+ * top level handler of the owning service. The function id must belong to a
+ * runtime service registered with DECLARE_RT_SVC().
+ */
+typedef struct rt_svc_fid_desc {
+	uint32_t smc_fid;
+	const char *name;
+	rt_svc_handle_t handle;
+} rt_svc_fid_desc_t;
+
+/*
+ * Entry of the SMC function id fast path table built by runtime_svc_init()
+ * from the 'rt_svc_fid_descs' linker section.
+ */
+typedef struct rt_svc_fid_entry {
+	u_register_t smc_fid;
+	rt_svc_handle_t handle;
+} rt_svc_fid_entry_t;
+
+/*
+ * Convenience macro to declare a fast path SMC function id descriptor. It is
+ * discarded unless SMC_FID_FAST_PATH is enabled.
+ */
+#if SMC_FID_FAST_PATH
+#define DECLARE_RT_SVC_FID(_name, _fid, _smch)				\
+	static const rt_svc_fid_desc_t __svc_fid_desc_ ## _name		\
+		__section("rt_svc_fid_descs") __used = {		\
+			.smc_fid = (_fid),				\
+			.name = #_name,					\
+			.handle = (_smch)				\
+		}
+#else
+#define DECLARE_RT_SVC_FID(_name, _fid, _smch)
+#endif
+
 /*
  * Compile time assertions related to the 'rt_svc_desc' structure to:
  * 1. ensure that the assembler and the compiler view of the size
@@ -97,6 +187,26 @@ CASSERT(RT_SVC_DESC_INIT == __builtin_offsetof(rt_svc_desc_t, init), \
 CASSERT(RT_SVC_DESC_HANDLE == __builtin_offsetof(rt_svc_desc_t, handle), \
 	assert_rt_svc_desc_handle_offset_mismatch);
 
+/*
+ * Compile time assertions to ensure that the assembler and the compiler agree
+ * on the size of a fast path table entry and on the offset of its handler.
+ */
+CASSERT((sizeof(rt_svc_fid_entry_t) == SIZEOF_RT_SVC_FID_ENTRY), \
+	assert_sizeof_rt_svc_fid_entry_mismatch);
+CASSERT(RT_SVC_FID_ENTRY_HANDLE == \
+	__builtin_offsetof(rt_svc_fid_entry_t, handle), \
+	assert_rt_svc_fid_entry_handle_offset_mismatch);
+CASSERT((RT_SVC_FID_TABLE_SIZE >= (4U * MAX_RT_SVC_FIDS)) && \
+	IS_POWER_OF_TWO(RT_SVC_FID_TABLE_SIZE), \
+	assert_rt_svc_fid_table_size);
+
+/* Returns the slot of the fast path table at which a lookup of smc_fid starts */
+static inline unsigned int rt_svc_fid_hash(uint32_t smc_fid)
+{
+	return (smc_fid ^ (smc_fid >> RT_SVC_FID_HASH_SHIFT)) &
+		(RT_SVC_FID_TABLE_SIZE - 1U);
+}
+
 
 /*
  * This function combines the call type and the owning entity number
@@ -128,11 +238,27 @@ static inline uint32_t get_unique_oen_from_smc_fid(uint32_t fid)
 void runtime_svc_init(void);
 uintptr_t handle_runtime_svc(uint32_t smc_fid, void *cookie, void *handle,
 						unsigned int flags);
+#if ENABLE_SMC_STAT
+void smc_stat_record(uint32_t smc_fid, uint64_t start);
+uintptr_t smc_stat_smc_handler(unsigned int smc_fid,
+		u_register_t x1,
+		u_register_t x2,
+		u_register_t x3,
+		u_register_t x4,
+		void *cookie,
+		void *handle,
+		u_register_t flags);
+#endif
 IMPORT_SYM(uintptr_t, __RT_SVC_DESCS_START__,		RT_SVC_DESCS_START);
 IMPORT_SYM(uintptr_t, __RT_SVC_DESCS_END__,		RT_SVC_DESCS_END);
+IMPORT_SYM(uintptr_t, __RT_SVC_FID_DESCS_START__,	RT_SVC_FID_DESCS_START);
+IMPORT_SYM(uintptr_t, __RT_SVC_FID_DESCS_END__,	RT_SVC_FID_DESCS_END);
 void init_crash_reporting(void);
 
 extern uint8_t rt_svc_descs_indices[MAX_RT_SVCS];
+#if SMC_FID_FAST_PATH
+extern rt_svc_fid_entry_t rt_svc_fid_table[RT_SVC_FID_TABLE_SIZE];
+#endif
 
 #endif /*__ASSEMBLER__*/
 #endif /* RUNTIME_SVC_H */
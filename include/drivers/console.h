@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2020, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -14,8 +14,9 @@
 #define CONSOLE_T_PUTC			(U(2) * REGSZ)
 #define CONSOLE_T_GETC			(U(3) * REGSZ)
 #define CONSOLE_T_FLUSH			(U(4) * REGSZ)
-#define CONSOLE_T_BASE			(U(5) * REGSZ)
-#define CONSOLE_T_DRVDATA		(U(6) * REGSZ)
+#define CONSOLE_T_WRITE			(U(5) * REGSZ)
+#define CONSOLE_T_BASE			(U(6) * REGSZ)
+#define CONSOLE_T_DRVDATA		(U(7) * REGSZ)
 
 #define CONSOLE_FLAG_BOOT		(U(1) << 0)
 #define CONSOLE_FLAG_RUNTIME		(U(1) << 1)
@@ -32,6 +33,7 @@
 
 #ifndef __ASSEMBLER__
 
+#include <stddef.h>
 #include <stdint.h>
 
 typedef struct console {
@@ -44,6 +46,13 @@ typedef struct console {
 	int (*const putc)(int character, struct console *console);
 	int (*const getc)(struct console *console);
 	int (*const flush)(struct console *console);
+	/*
+	 * Optional callback to output a buffer of characters, which lets the
+	 * driver fill its transmit FIFO with several characters per status
+	 * check. It returns the number of characters written, or a negative
+	 * error code. Consoles without it are fed one character at a time.
+	 */
+	int (*const write)(const char *buf, size_t len, struct console *console);
 	uintptr_t base;
 	/* Additional private driver data may follow here. */
 } console_t;
@@ -73,6 +82,8 @@ void console_set_scope(console_t *console, unsigned int scope);
 void console_switch_state(unsigned int new_state);
 /* Output a character on all consoles registered for the current state. */
 int console_putc(int c);
+/* Output a buffer on all consoles registered for the current state. */
+int console_write(const char *buf, size_t len);
 /* Read a character (blocking) from any console registered for current state. */
 int console_getc(void);
 /* Flush all consoles registered for the current state. */
@@ -46,6 +46,9 @@
 #define UARTFCR_RXCLR		(1 << 1)	/* Clear contents of Rx FIFO */
 #define UARTFCR_FIFOEN		(1 << 0)	/* Enable the Tx/Rx FIFO */
 
+/* Depth of the transmit FIFO, when enabled */
+#define UART16550_TX_FIFO_SIZE	16
+
 /* Line Control Register bits */
 #define UARTLCR_DLAB		(1 << 7)	/* Divisor Latch Access */
 #define UARTLCR_SETB		(1 << 6)	/* Set BREAK Condition */
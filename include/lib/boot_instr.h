@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2020, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef BOOT_INSTR_H
+#define BOOT_INSTR_H
+
+#include <lib/utils_def.h>
+
+/* Cold boot phase boundaries */
+#define BOOT_INSTR_BL1_ENTRY		U(0)
+#define BOOT_INSTR_BL1_EXIT		U(1)
+#define BOOT_INSTR_BL2_ENTRY		U(2)
+#define BOOT_INSTR_BL2_EXIT		U(3)
+#define BOOT_INSTR_BL31_ENTRY		U(4)
+#define BOOT_INSTR_BL31_BL32_INIT	U(5)
+#define BOOT_INSTR_BL31_EXIT		U(6)
+#define BOOT_INSTR_NUM_PHASES		U(8)
+
+/*
+ * Start and end of the loading and authentication of each image, by image ID.
+ * Image IDs from BOOT_INSTR_MAX_IMAGES are not recorded.
+ */
+#define BOOT_INSTR_MAX_IMAGES		U(48)
+#define BOOT_INSTR_IMAGE_LOAD_START(_id)	\
+	(BOOT_INSTR_NUM_PHASES + ((_id) * U(2)))
+#define BOOT_INSTR_IMAGE_LOAD_END(_id)		\
+	(BOOT_INSTR_IMAGE_LOAD_START(_id) + U(1))
+
+#define BOOT_INSTR_TOTAL_IDS		\
+	BOOT_INSTR_IMAGE_LOAD_START(BOOT_INSTR_MAX_IMAGES)
+
+#ifndef __ASSEMBLER__
+
+/* Only BL1, BL2 and BL31 record the boot phases */
+#if ENABLE_BOOT_INSTRUMENTATION && \
+	(defined(IMAGE_BL1) || defined(IMAGE_BL2) || defined(IMAGE_BL31))
+#include <arch_helpers.h>
+
+void boot_instr_mark_entry(void);
+void boot_instr_setup(unsigned int tid);
+void boot_instr_write(unsigned int tid, unsigned long long ts);
+
+/*
+ * The entry of an image is marked as early as possible, before its memory
+ * map is set up, and recorded by BOOT_INSTR_SETUP() once it is.
+ */
+#define BOOT_INSTR_MARK_ENTRY()		boot_instr_mark_entry()
+#define BOOT_INSTR_SETUP(_tid)		boot_instr_setup(_tid)
+#define BOOT_INSTR_CAPTURE(_tid)	\
+	boot_instr_write((_tid), read_cntpct_el0())
+#else
+#define BOOT_INSTR_MARK_ENTRY()
+#define BOOT_INSTR_SETUP(_tid)
+#define BOOT_INSTR_CAPTURE(_tid)
+#endif
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* BOOT_INSTR_H */
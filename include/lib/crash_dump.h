@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2020, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef CRASH_DUMP_H
+#define CRASH_DUMP_H
+
+#include <lib/utils_def.h>
+
+/*
+ * Layout of the crash dump region. The region starts with one record per CPU,
+ * indexed by the linear index of the CPU, followed by a copy of the log ring
+ * when ENABLE_LOG_RING is set. All fields are little-endian 64-bit values,
+ * except the magic and the reason of the CPU records which are 32-bit values.
+ * The magic of a record is written last, once the rest of it is valid.
+ */
+#define CRASH_DUMP_MAGIC		U(0x44434654)	/* "TFCD" */
+#define CRASH_DUMP_LOG_MAGIC		U(0x474c4654)	/* "TFLG" */
+
+/* Reasons for a crash dump */
+#define CRASH_DUMP_REASON_PANIC		U(1)
+#define CRASH_DUMP_REASON_EXCEPTION	U(2)
+#define CRASH_DUMP_REASON_INTERRUPT	U(3)
+#define CRASH_DUMP_REASON_ELX_PANIC	U(4)
+
+/* Maximum number of return addresses of the backtrace of a CPU record */
+#define CRASH_DUMP_BT_DEPTH		U(16)
+
+/* Offsets in a CPU record */
+#define CRASH_DUMP_MAGIC_OFF		U(0x0)
+#define CRASH_DUMP_REASON_OFF		U(0x4)
+#define CRASH_DUMP_TS_OFF		U(0x8)
+#define CRASH_DUMP_MPIDR_OFF		U(0x10)
+#define CRASH_DUMP_X0_OFF		U(0x18)	/* x0 to x30 */
+#define CRASH_DUMP_SP_EL0_OFF		U(0x110)
+#define CRASH_DUMP_ELR_EL3_OFF		U(0x118)
+#define CRASH_DUMP_SPSR_EL3_OFF		U(0x120)
+#define CRASH_DUMP_ESR_EL3_OFF		U(0x128)
+#define CRASH_DUMP_FAR_EL3_OFF		U(0x130)
+#define CRASH_DUMP_SCR_EL3_OFF		U(0x138)
+#define CRASH_DUMP_SCTLR_EL3_OFF	U(0x140)
+#define CRASH_DUMP_ELR_EL1_OFF		U(0x148)
+#define CRASH_DUMP_SPSR_EL1_OFF		U(0x150)
+#define CRASH_DUMP_ESR_EL1_OFF		U(0x158)
+#define CRASH_DUMP_FAR_EL1_OFF		U(0x160)
+#define CRASH_DUMP_SCTLR_EL1_OFF	U(0x168)
+#define CRASH_DUMP_SP_EL1_OFF		U(0x170)
+#define CRASH_DUMP_BT_DEPTH_OFF		U(0x178)
+#define CRASH_DUMP_BT_OFF		U(0x180)
+#define CRASH_DUMP_CPU_SIZE		U(0x200)
+
+/*
+ * Offsets in the log ring copy, which follows the CPU records. The records of
+ * the log ring are copied as they are, up to the end of the region.
+ */
+#define CRASH_DUMP_LOG_OFF		(PLATFORM_CORE_COUNT * CRASH_DUMP_CPU_SIZE)
+#define CRASH_DUMP_LOG_MAGIC_OFF	U(0x0)
+#define CRASH_DUMP_LOG_HEAD_OFF		U(0x8)
+#define CRASH_DUMP_LOG_SIZE_OFF		U(0x10)
+#define CRASH_DUMP_LOG_RECS_OFF		U(0x18)
+
+#endif /* CRASH_DUMP_H */
@@ -49,6 +49,7 @@ int create(const char *name, int flags);
 int open(const char *name, int flags);
 int close(int fd);
 int read(int fd, void *buf, int n);
+int readn(int fd, void *buf, int n);
 int write(int fd, void *buf, int n);
 int seek(int fd, long off, int whence);
 int bind(const char *path, const char *where);
@@ -59,7 +60,15 @@ void debugfs_init(void);
 int debugfs_smc_setup(void);
 
 /* Debugfs version returned through SMC interface */
-#define DEBUGFS_VERSION		(0x000000001U)
+#define DEBUGFS_VERSION		(0x000000002U)
+
+/*
+ * Maximum size of the NS shared buffer negotiated on INIT, as a multiple of
+ * 4KB. Sizes above 2MB require more translation tables.
+ */
+#ifndef PLAT_DEBUGFS_SHARED_BUF_MAX_SIZE
+#define PLAT_DEBUGFS_SHARED_BUF_MAX_SIZE	(0x10000U)
+#endif
 
 /* Function ID for accessing the debugfs interface */
 #define DEBUGFS_FID_VALUE	(0x30U)
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2020, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef EL3_PROF_H
+#define EL3_PROF_H
+
+#include <lib/utils_def.h>
+
+/*
+ * SMC function IDs of the EL3 profiler, when ENABLE_EL3_PROF is set.
+ *
+ * EL3_PROF_SMC_START_64: start sampling on the calling CPU, clearing its
+ * histogram.
+ * x1: Sampling period, in cycles spent in EL3
+ *
+ * EL3_PROF_SMC_STOP_64: stop sampling on the calling CPU.
+ *
+ * EL3_PROF_SMC_READ_64: copy the histogram of a CPU to a Non-secure buffer,
+ * as an array of 32-bit sample counts, one per bucket.
+ * x1: MPIDR of the CPU
+ * x2: Physical address of the buffer
+ * x3: Size of the buffer
+ * Returns the error code in x0, the address of the first bucket in x1, the
+ * size of a bucket as a shift in x2, the number of buckets in x3 and the
+ * number of samples which couldn't be attributed to an address in x4.
+ */
+#define EL3_PROF_SMC_START_64		U(0xC2000050)
+#define EL3_PROF_SMC_STOP_64		U(0xC2000051)
+#define EL3_PROF_SMC_READ_64		U(0xC2000052)
+#define EL3_PROF_NUM_SMC_CALLS		3
+
+/* The macros below are used to identify profiler calls from the SMC ID */
+#define EL3_PROF_FID_MASK		U(0xffe0)
+#define EL3_PROF_FID_VALUE		U(0x50)
+#define is_el3_prof_fid(_fid)	\
+	(((_fid) & EL3_PROF_FID_MASK) == EL3_PROF_FID_VALUE)
+
+/* Size of a histogram bucket, as a shift, and number of buckets */
+#ifndef PLAT_EL3_PROF_BUCKET_SHIFT
+#define PLAT_EL3_PROF_BUCKET_SHIFT	U(7)
+#endif
+#ifndef PLAT_EL3_PROF_BUCKETS
+#define PLAT_EL3_PROF_BUCKETS		U(1024)
+#endif
+
+#ifndef __ASSEMBLER__
+
+#include <stdint.h>
+
+void el3_prof_init(void);
+void el3_prof_stop(void);
+int el3_prof_handle_fiq(u_register_t elr);
+uintptr_t el3_prof_smc_handler(unsigned int smc_fid,
+		u_register_t x1,
+		u_register_t x2,
+		u_register_t x3,
+		u_register_t x4,
+		void *cookie,
+		void *handle,
+		u_register_t flags);
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* EL3_PROF_H */
@@ -9,6 +9,10 @@
 
 #include <lib/utils_def.h>
 
+#if CTX_HOT_REGS_FIRST
+#include <platform_def.h>	/* CACHE_WRITEBACK_GRANULE required */
+#endif
+
 /*******************************************************************************
  * Constants that allow assembler code to access members of and the 'gp_regs'
  * structure at their correct offsets.
@@ -68,7 +72,18 @@
  * registers are only 32-bits wide but are stored as 64-bit values for
  * convenience
  ******************************************************************************/
+#if CTX_HOT_REGS_FIRST
+/*
+ * The registers accessed on every exception entry and exit precede the EL1
+ * system registers, which start on a new cache line.
+ */
+#define CTX_HOT_REGS_END	(CTX_PAUTH_REGS_OFFSET + CTX_PAUTH_REGS_END)
+#define CTX_EL1_SYSREGS_OFFSET	((CTX_HOT_REGS_END +			\
+				  CACHE_WRITEBACK_GRANULE - 1) &	\
+				 ~(CACHE_WRITEBACK_GRANULE - 1))
+#else
 #define CTX_EL1_SYSREGS_OFFSET	(CTX_EL3STATE_OFFSET + CTX_EL3STATE_END)
+#endif
 #define CTX_SPSR_EL1		U(0x0)
 #define CTX_ELR_EL1		U(0x8)
 #define CTX_SCTLR_EL1		U(0x10)
@@ -299,7 +314,11 @@
 /*******************************************************************************
  * Registers related to CVE-2018-3639
  ******************************************************************************/
+#if CTX_HOT_REGS_FIRST
+#define CTX_CVE_2018_3639_OFFSET	(CTX_EL3STATE_OFFSET + CTX_EL3STATE_END)
+#else
 #define CTX_CVE_2018_3639_OFFSET	(CTX_FPREGS_OFFSET + CTX_FPREGS_END)
+#endif
 #define CTX_CVE_2018_3639_DISABLE	U(0)
 #define CTX_CVE_2018_3639_END		U(0x10) /* Align to the next 16 byte boundary */
 
@@ -417,21 +436,36 @@ DEFINE_REG_STRUCT(pauth, CTX_PAUTH_REGS_ALL);
  * to ensure that SP_EL3 always points to an instance of this
  * structure at exception entry and exit. Each instance will
  * correspond to either the secure or the non-secure state.
+ *
+ * When CTX_HOT_REGS_FIRST is set, the members accessed on every exception
+ * entry and exit are grouped in the first cache lines and the remaining ones
+ * start on a new cache line. The structure is then cache line aligned so that
+ * the contexts of different CPUs never share a cache line.
  */
 typedef struct cpu_context {
 	gp_regs_t gpregs_ctx;
 	el3_state_t el3state_ctx;
+#if CTX_HOT_REGS_FIRST
+	cve_2018_3639_t cve_2018_3639_ctx;
+#if CTX_INCLUDE_PAUTH_REGS
+	pauth_t pauth_ctx;
+#endif
+	el1_sysregs_t el1_sysregs_ctx __aligned(CACHE_WRITEBACK_GRANULE);
+#else
 	el1_sysregs_t el1_sysregs_ctx;
+#endif
 #if CTX_INCLUDE_EL2_REGS
 	el2_sysregs_t el2_sysregs_ctx;
 #endif
 #if CTX_INCLUDE_FPREGS
 	fp_regs_t fpregs_ctx;
 #endif
+#if !CTX_HOT_REGS_FIRST
 	cve_2018_3639_t cve_2018_3639_ctx;
 #if CTX_INCLUDE_PAUTH_REGS
 	pauth_t pauth_ctx;
 #endif
+#endif
 } cpu_context_t;
 
 /* Macros to access members of the 'cpu_context_t' structure */
@@ -517,6 +551,13 @@ CASSERT(CTX_PAUTH_REGS_OFFSET == __builtin_offsetof(cpu_context_t, pauth_ctx), \
 void el1_sysregs_context_save(el1_sysregs_t *regs);
 void el1_sysregs_context_restore(el1_sysregs_t *regs);
 
+#if CTX_LAZY_SYSREGS
+#if CTX_INCLUDE_AARCH32_REGS
+void el1_aarch32_sysregs_context_save(el1_sysregs_t *regs);
+void el1_aarch32_sysregs_context_restore(el1_sysregs_t *regs);
+#endif
+#endif /* CTX_LAZY_SYSREGS */
+
 #if CTX_INCLUDE_EL2_REGS
 void el2_sysregs_context_save(el2_sysregs_t *regs);
 void el2_sysregs_context_restore(el2_sysregs_t *regs);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2014-2020, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -63,6 +63,16 @@
 #define CPU_DATA_PMF_TS0_IDX		0
 #endif
 
+#if ENABLE_EL3_PROF
+/* Non-zero while the EL3 profiler samples the SMC handlers of the CPU */
+#if ENABLE_RUNTIME_INSTRUMENTATION
+#define CPU_DATA_EL3_PROF_ARMED_OFFSET	(CPU_DATA_PMF_TS0_OFFSET + \
+						(CPU_DATA_PMF_TS_COUNT << 3))
+#else
+#define CPU_DATA_EL3_PROF_ARMED_OFFSET	CPU_DATA_CRASH_BUF_END
+#endif
+#endif
+
 #ifndef __ASSEMBLER__
 
 #include <arch_helpers.h>
@@ -112,6 +122,9 @@ typedef struct cpu_data {
 #if ENABLE_RUNTIME_INSTRUMENTATION
 	uint64_t cpu_data_pmf_ts[CPU_DATA_PMF_TS_COUNT];
 #endif
+#if ENABLE_EL3_PROF
+	u_register_t el3_prof_armed;
+#endif
 #if PLAT_PCPU_DATA_SIZE
 	uint8_t platform_cpu_data[PLAT_PCPU_DATA_SIZE];
 #endif
@@ -148,6 +161,12 @@ CASSERT(CPU_DATA_PMF_TS0_OFFSET == __builtin_offsetof
 		assert_cpu_data_pmf_ts0_offset_mismatch);
 #endif
 
+#if ENABLE_EL3_PROF
+CASSERT(CPU_DATA_EL3_PROF_ARMED_OFFSET == __builtin_offsetof
+		(cpu_data_t, el3_prof_armed),
+		assert_cpu_data_el3_prof_armed_offset_mismatch);
+#endif
+
 struct cpu_data *_cpu_data_by_index(uint32_t cpu_index);
 
 #ifdef __aarch64__
@@ -21,8 +21,10 @@
  * are declared. Only then would ARRAY_SIZE() yield a meaningful value.
  */
 #define REGISTER_ERR_RECORD_INFO(_records) \
+	static struct err_record_stat _records##_stats[ARRAY_SIZE(_records)]; \
 	const struct err_record_mapping err_record_mappings = { \
 		.err_records = (_records), \
+		.stats = _records##_stats, \
 		.num_err_records = ARRAY_SIZE(_records), \
 	}
 
@@ -157,8 +159,27 @@ struct err_record_info {
 	unsigned int access:1;
 };
 
+/* Statistics of the errors handled from an error record group */
+struct err_record_stat {
+	/* Total number of errors handled */
+	uint64_t count;
+
+	/* Start of the current accounting window, in system counter ticks */
+	uint64_t window_start;
+
+	/* Time of the last escalation, in system counter ticks */
+	uint64_t last_escalation;
+
+	/* Number of errors handled in the current accounting window */
+	unsigned int window_count;
+
+	/* Number of corrected errors coalesced since the last escalation */
+	unsigned int ce_pending;
+};
+
 struct err_record_mapping {
 	struct err_record_info *err_records;
+	struct err_record_stat *stats;
 	size_t num_err_records;
 };
 
@@ -194,6 +215,8 @@ static inline int ras_err_ser_probe_sysreg(const struct err_record_info *info,
 }
 
 const char *ras_serr_to_str(unsigned int serr);
+uint64_t ras_err_record_count(const struct err_record_info *info);
+unsigned int ras_err_ce_coalesce(const struct err_record_info *info);
 int ras_ea_handler(unsigned int ea_reason, uint64_t syndrome, void *cookie,
 		void *handle, uint64_t flags);
 void ras_init(void);
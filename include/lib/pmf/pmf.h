@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2020, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -40,7 +40,16 @@
  */
 #define PMF_SMC_GET_TIMESTAMP_32	U(0x82000010)
 #define PMF_SMC_GET_TIMESTAMP_64	U(0xC2000010)
-#define PMF_NUM_SMC_CALLS		2
+#define PMF_SMC_TRACE_READ_64		U(0xC2000011)
+#define PMF_SMC_GET_TIMESTAMPS_64	U(0xC2000012)
+#if PMF_TRACE
+#define PMF_NUM_SMC_CALLS		4
+#else
+#define PMF_NUM_SMC_CALLS		3
+#endif
+
+/* Maximum number of trace entries returned by one PMF_SMC_TRACE_READ_64 call */
+#define PMF_TRACE_READ_MAX		3
 
 /*
  * The macros below are used to identify
@@ -53,6 +62,19 @@
 /* Following are the supported PMF service IDs */
 #define PMF_PSCI_STAT_SVC_ID	0
 #define PMF_RT_INSTR_SVC_ID	1
+#define PMF_SPMD_SVC_ID		2
+#define PMF_SDEI_SVC_ID		3
+#define PMF_BOOT_INSTR_SVC_ID	4
+
+/*
+ * Entry of the per-cpu trace buffers. `tid` includes the service ID, and `arg`
+ * is an event-specific argument, e.g. the function ID for SMC timestamps.
+ */
+typedef struct pmf_trace_entry {
+	unsigned long long ts;
+	unsigned int tid;
+	unsigned int arg;
+} pmf_trace_entry_t;
 
 /*******************************************************************************
  * Function & variable prototypes
@@ -62,7 +84,17 @@ int pmf_get_timestamp_smc(unsigned int tid,
 		u_register_t mpidr,
 		unsigned int flags,
 		unsigned long long *ts_value);
+int pmf_get_timestamps_smc(unsigned int tid,
+		unsigned long long buf_pa,
+		size_t buf_size,
+		unsigned int flags,
+		unsigned int *num_ids);
 int pmf_setup(void);
+int pmf_trace_read(u_register_t mpidr,
+		unsigned long long seq,
+		pmf_trace_entry_t *entries,
+		unsigned long long *first_seq);
+void pmf_trace_rt_instr(unsigned int tid, unsigned int arg);
 uintptr_t pmf_smc_handler(unsigned int smc_fid,
 		u_register_t x1,
 		u_register_t x2,
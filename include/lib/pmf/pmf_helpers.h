@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2020, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -22,6 +22,9 @@ typedef int (*pmf_svc_init_t)(void);
 typedef unsigned long long (*pmf_svc_get_ts_t)(unsigned int tid,
 		 u_register_t mpidr,
 		 unsigned int flags);
+typedef unsigned long long (*pmf_svc_get_ts_by_index_t)(unsigned int tid,
+		 unsigned int cpuid,
+		 unsigned int flags);
 
 /*
  * This is the definition of PMF service desc.
@@ -41,6 +44,12 @@ typedef struct pmf_svc_desc {
 
 	/* PMF service time-stamp retrieval handler */
 	pmf_svc_get_ts_t get_ts;
+
+	/*
+	 * PMF service time-stamp retrieval handler by cpu index, used for bulk
+	 * retrieval. Optional.
+	 */
+	pmf_svc_get_ts_by_index_t get_ts_by_index;
 } pmf_svc_desc_t;
 
 #if ENABLE_PMF
@@ -109,7 +118,7 @@ typedef struct pmf_svc_desc {
  */
 #define PMF_REGISTER_SERVICE(_name, _svcid, _totalid, _flags)	\
 	PMF_ALLOCATE_TIMESTAMP_MEMORY(_name, _totalid)		\
-	PMF_DEFINE_CAPTURE_TIMESTAMP(_name, _flags)		\
+	PMF_DEFINE_CAPTURE_TIMESTAMP(_name, _svcid, _flags)	\
 	PMF_DEFINE_GET_TIMESTAMP(_name)
 
 /*
@@ -120,7 +129,8 @@ typedef struct pmf_svc_desc {
 	PMF_REGISTER_SERVICE(_name, _svcid, _totalid, _flags)	\
 	PMF_DEFINE_SERVICE_DESC(_name, PMF_ARM_TIF_IMPL_ID,	\
 			_svcid, _totalid, NULL,			\
-			pmf_get_timestamp_by_mpidr_ ## _name)
+			pmf_get_timestamp_by_mpidr_ ## _name,	\
+			pmf_get_timestamp_by_index_ ## _name)
 
 /*
  * This macro is used to register a PMF service that has an SMC interface
@@ -129,7 +139,7 @@ typedef struct pmf_svc_desc {
 #define PMF_REGISTER_SERVICE_SMC_OWN(_name, _implid, _svcid, _totalid,	\
 		 _init, _getts)						\
 	PMF_DEFINE_SERVICE_DESC(_name, _implid, _svcid, _totalid,	\
-		 _init, _getts)
+		 _init, _getts, NULL)
 
 #else
 
@@ -163,12 +173,24 @@ typedef struct pmf_svc_desc {
 #define PMF_VALIDATE_TID(_name, _tid)	\
 	assert((_tid & PMF_TID_MASK) < (ARRAY_SIZE(pmf_ts_mem_ ## _name)))
 
+/*
+ * Convenience macro to record a stored time-stamp in the trace buffer of the
+ * current cpu.
+ */
+#if PMF_TRACE
+#define PMF_TRACE_TIMESTAMP(_svcid, _tid, _ts, _flags)			\
+	__pmf_trace_timestamp((((_svcid) << PMF_SVC_ID_SHIFT) &		\
+			PMF_SVC_ID_MASK) | (_tid), (_ts), 0U, (_flags))
+#else
+#define PMF_TRACE_TIMESTAMP(_svcid, _tid, _ts, _flags)
+#endif
+
 /*
  * Convenience macros for capturing time-stamp.
  *
  * The extern declaration is there to satisfy MISRA C-2012 rule 8.4.
  */
-#define PMF_DEFINE_CAPTURE_TIMESTAMP(_name, _flags)			\
+#define PMF_DEFINE_CAPTURE_TIMESTAMP(_name, _svcid, _flags)		\
 	void pmf_capture_timestamp_ ## _name(				\
 			unsigned int tid,				\
 			unsigned long long ts)				\
@@ -176,8 +198,11 @@ typedef struct pmf_svc_desc {
 		CASSERT(_flags != 0, select_proper_config);		\
 		PMF_VALIDATE_TID(_name, tid);				\
 		uintptr_t base_addr = (uintptr_t) pmf_ts_mem_ ## _name;	\
-		if (((_flags) & PMF_STORE_ENABLE) != 0)			\
+		if (((_flags) & PMF_STORE_ENABLE) != 0) {		\
 			__pmf_store_timestamp(base_addr, tid, ts);	\
+			PMF_TRACE_TIMESTAMP(_svcid, tid, ts,		\
+					PMF_NO_CACHE_MAINT);		\
+		}							\
 		if (((_flags) & PMF_DUMP_ENABLE) != 0)			\
 			__pmf_dump_timestamp(tid, ts);			\
 	}								\
@@ -188,8 +213,11 @@ typedef struct pmf_svc_desc {
 		CASSERT(_flags != 0, select_proper_config);		\
 		PMF_VALIDATE_TID(_name, tid);				\
 		uintptr_t base_addr = (uintptr_t) pmf_ts_mem_ ## _name;	\
-		if (((_flags) & PMF_STORE_ENABLE) != 0)			\
+		if (((_flags) & PMF_STORE_ENABLE) != 0) {		\
 			__pmf_store_timestamp_with_cache_maint(base_addr, tid, ts);\
+			PMF_TRACE_TIMESTAMP(_svcid, tid, ts,		\
+					PMF_CACHE_MAINT);		\
+		}							\
 		if (((_flags) & PMF_DUMP_ENABLE) != 0)			\
 			__pmf_dump_timestamp(tid, ts);			\
 	}
@@ -221,7 +249,7 @@ typedef struct pmf_svc_desc {
  * This is needed for services that require SMC handling.
  */
 #define PMF_DEFINE_SERVICE_DESC(_name, _implid, _svcid, _totalid,	\
-		_init, _getts_by_mpidr) 				\
+		_init, _getts_by_mpidr, _getts_by_index)		\
 	static const pmf_svc_desc_t __pmf_desc_ ## _name 		\
 	__section("pmf_svc_descs") __used = {		 		\
 		.h.type = PARAM_EP, 					\
@@ -236,7 +264,8 @@ typedef struct pmf_svc_desc {
 				(((_totalid) << PMF_TID_SHIFT) &	\
 						PMF_TID_MASK)),		\
 		.init = _init,						\
-		.get_ts = _getts_by_mpidr				\
+		.get_ts = _getts_by_mpidr,				\
+		.get_ts_by_index = _getts_by_index			\
 	};
 
 /* PMF internal functions */
@@ -251,4 +280,8 @@ unsigned long long __pmf_get_timestamp(uintptr_t base_addr,
 		unsigned int tid,
 		unsigned int cpuid,
 		unsigned int flags);
+void __pmf_trace_timestamp(unsigned int tid,
+		unsigned long long ts,
+		unsigned int arg,
+		unsigned int flags);
 #endif /* PMF_HELPERS_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2020, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -15,7 +15,13 @@
 #define RT_INSTR_EXIT_HW_LOW_PWR	U(3)
 #define RT_INSTR_ENTER_CFLUSH		U(4)
 #define RT_INSTR_EXIT_CFLUSH		U(5)
+#if ENABLE_SMC_INSTRUMENTATION
+#define RT_INSTR_ENTER_SMC		U(6)
+#define RT_INSTR_EXIT_SMC		U(7)
+#define RT_INSTR_TOTAL_IDS		U(8)
+#else
 #define RT_INSTR_TOTAL_IDS		U(6)
+#endif
 
 #ifndef __ASSEMBLER__
 PMF_DECLARE_CAPTURE_TIMESTAMP(rt_instr_svc)
@@ -242,7 +242,8 @@ void xlat_setup_dynamic_ctx(xlat_ctx_t *ctx, unsigned long long pa_max,
 			    uintptr_t va_max, struct mmap_region *mmap,
 			    unsigned int mmap_num, uint64_t **tables,
 			    unsigned int tables_num, uint64_t *base_table,
-			    int xlat_regime, int *mapped_regions);
+			    int xlat_regime, int *mapped_regions,
+			    int *free_tables);
 
 /*
  * Add a static region with defined base PA and base VA. This function can only
@@ -359,7 +360,10 @@ int mmap_remove_dynamic_region_ctx(xlat_ctx_t *ctx,
  * NOTE: The caller of this function must be able to write to the translation
  * tables, i.e. the memory where they are stored must be mapped with read-write
  * access permissions. This function assumes it is the case. If this is not
- * the case then this function might trigger a data abort exception.
+ * the case then this function might trigger a data abort exception. If the
+ * tables are known to be read-only, because they have been made so by
+ * xlat_make_tables_readonly() or have been generated at build time in
+ * read-only memory, -EPERM is returned.
  *
  * NOTE2: The caller is responsible for making sure that the targeted
  * translation tables are not modified by any other code while this function is
@@ -71,15 +71,26 @@ struct xlat_ctx {
 	 */
 	uint64_t (*tables)[XLAT_TABLE_ENTRIES];
 	int tables_num;
-#if PLAT_RO_XLAT_TABLES
+	/*
+	 * Set when the translation tables are in read-only memory, after
+	 * xlat_make_tables_readonly() or when they are generated at build time
+	 * without dynamic regions.
+	 */
 	bool readonly_tables;
-#endif
 	/*
 	 * Keep track of how many regions are mapped in each table. The base
 	 * table can't be unmapped so it isn't needed to keep track of it.
 	 */
 #if PLAT_XLAT_TABLES_DYNAMIC
 	int *tables_mapped_regions;
+
+	/*
+	 * Stack of the indices of the tables that don't have any region
+	 * mapped, so that an empty table can be found without searching for
+	 * it. `tables_free_num` is the number of indices in the stack.
+	 */
+	int *tables_free;
+	int tables_free_num;
 #endif /* PLAT_XLAT_TABLES_DYNAMIC */
 
 	int next_table;
@@ -114,10 +125,13 @@ struct xlat_ctx {
 
 #if PLAT_XLAT_TABLES_DYNAMIC
 #define XLAT_ALLOC_DYNMAP_STRUCT(_ctx_name, _xlat_tables_count)		\
-	static int _ctx_name##_mapped_regions[_xlat_tables_count];
+	static int _ctx_name##_mapped_regions[_xlat_tables_count];	\
+	static int _ctx_name##_free_tables[_xlat_tables_count];
 
 #define XLAT_REGISTER_DYNMAP_STRUCT(_ctx_name)				\
-	.tables_mapped_regions = _ctx_name##_mapped_regions,
+	.tables_mapped_regions = _ctx_name##_mapped_regions,		\
+	.tables_free = _ctx_name##_free_tables,				\
+	.tables_free_num = 0,
 #else
 #define XLAT_ALLOC_DYNMAP_STRUCT(_ctx_name, _xlat_tables_count)		\
 	/* do nothing */
@@ -126,13 +140,8 @@ struct xlat_ctx {
 	/* do nothing */
 #endif /* PLAT_XLAT_TABLES_DYNAMIC */
 
-#if PLAT_RO_XLAT_TABLES
 #define XLAT_CTX_INIT_TABLE_ATTR()					\
 	.readonly_tables = false,
-#else
-#define XLAT_CTX_INIT_TABLE_ATTR()
-	/* do nothing */
-#endif
 
 #define REGISTER_XLAT_CONTEXT_FULL_SPEC(_ctx_name, _mmap_count,		\
 			_xlat_tables_count, _virt_addr_space_size,	\
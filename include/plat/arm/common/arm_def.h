@@ -171,6 +171,9 @@
 #define ARM_IRQ_SEC_SGI_6		14
 #define ARM_IRQ_SEC_SGI_7		15
 
+/* PMU overflow interrupt, taken in EL3 while the EL3 profiler samples */
+#define ARM_IRQ_PMU			23
+
 /*
  * Define a list of Group 1 Secure and Group 0 interrupt properties as per GICv3
  * terminology. On a GICv2 system or mode, the lists will be merged and treated
@@ -566,6 +569,8 @@
 #define PLAT_RAS_PRI			0x10
 #define PLAT_SDEI_CRITICAL_PRI		0x60
 #define PLAT_SDEI_NORMAL_PRI		0x70
+#define PLAT_EL3_PROF_PRI		0x50
+#define PLAT_EL3_PROF_PMU_IRQ		ARM_IRQ_PMU
 
 /* ARM platforms use 3 upper bits of secure interrupt priority */
 #define PLAT_PRI_BITS			3
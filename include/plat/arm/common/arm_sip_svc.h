@@ -25,6 +25,15 @@
 /* DEBUGFS_SMC_32			0x82000030U */
 /* DEBUGFS_SMC_64			0xC2000030U */
 
+/* EHF_SMC_GET_STAT_64			0xC2000040U */
+
+/* EL3_PROF_SMC_START_64		0xC2000050U */
+/* EL3_PROF_SMC_STOP_64			0xC2000051U */
+/* EL3_PROF_SMC_READ_64			0xC2000052U */
+
+/* SMC_STAT_SMC_GET_OEN_64		0xC2000060U */
+/* SMC_STAT_SMC_GET_FID_64		0xC2000061U */
+
 /* ARM SiP Service Calls version numbers */
 #define ARM_SIP_SVC_VERSION_MAJOR		U(0x0)
 #define ARM_SIP_SVC_VERSION_MINOR		U(0x2)
@@ -346,4 +346,10 @@ int32_t plat_get_soc_revision(void);
  */
 int32_t plat_is_smccc_feature_available(u_register_t fid);
 
+/*
+ * Optional function to check that a buffer passed by the Non-secure world lies
+ * within Non-secure memory
+ */
+int plat_validate_ns_buffer(unsigned long long base, size_t size);
+
 #endif /* PLATFORM_H */
@@ -7,6 +7,7 @@
 #ifndef SDEI_H
 #define SDEI_H
 
+#include <lib/pmf/pmf.h>
 #include <lib/spinlock.h>
 #include <lib/utils_def.h>
 #include <services/sdei_flags.h>
@@ -42,6 +43,23 @@
 #define SDEI_EV_HANDLED		0U
 #define SDEI_EV_FAILED		1U
 
+/*
+ * SDEI runtime instrumentation timestamp ids, recorded on the CPU handling the
+ * event:
+ *
+ * - SMC entry of SDEI_EVENT_SIGNAL.
+ * - Entry of the SDEI interrupt handler, after the interrupt is acknowledged.
+ * - Non-secure context ready to enter the client handler of the event.
+ * - SMC entry of SDEI_EVENT_COMPLETE or SDEI_EVENT_COMPLETE_AND_RESUME.
+ * - Dispatch ended, interrupted context ready to be resumed.
+ */
+#define SDEI_INSTR_SIGNAL		U(0)
+#define SDEI_INSTR_INTR_ENTER		U(1)
+#define SDEI_INSTR_DISPATCH		U(2)
+#define SDEI_INSTR_COMPLETE		U(3)
+#define SDEI_INSTR_RESUME		U(4)
+#define SDEI_INSTR_TOTAL_IDS		U(5)
+
 /* Indices of private and shared mappings */
 #define SDEI_MAP_IDX_PRIV_	0U
 #define SDEI_MAP_IDX_SHRD_	1U
@@ -134,6 +152,9 @@ uint64_t sdei_smc_handler(uint32_t smc_fid,
 
 void sdei_init(void);
 
+PMF_DECLARE_CAPTURE_TIMESTAMP(sdei_svc)
+PMF_DECLARE_GET_TIMESTAMP(sdei_svc)
+
 /* Public API to dispatch an event to Normal world */
 int sdei_dispatch_event(int ev_num);
 
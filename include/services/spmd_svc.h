@@ -7,10 +7,27 @@
 #ifndef SPMD_SVC_H
 #define SPMD_SVC_H
 
+#include <lib/utils_def.h>
+
+/*
+ * SPMD runtime instrumentation timestamp ids. For each forwarding direction,
+ * the SMC entry time of the forwarded call and the time at which the context
+ * of the other security state is ready to be entered are recorded.
+ */
+#define SPMD_INSTR_ENTER_NWD_FWD	U(0)
+#define SPMD_INSTR_EXIT_NWD_FWD		U(1)
+#define SPMD_INSTR_ENTER_SWD_FWD	U(2)
+#define SPMD_INSTR_EXIT_SWD_FWD		U(3)
+#define SPMD_INSTR_TOTAL_IDS		U(4)
+
 #ifndef __ASSEMBLER__
+#include <lib/pmf/pmf.h>
 #include <services/ffa_svc.h>
 #include <stdint.h>
 
+PMF_DECLARE_CAPTURE_TIMESTAMP(spmd_svc)
+PMF_DECLARE_GET_TIMESTAMP(spmd_svc)
+
 int spmd_setup(void);
 uint64_t spmd_smc_handler(uint32_t smc_fid,
 			  uint64_t x1,
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2020, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <lib/boot_instr.h>
+#include <lib/cassert.h>
+#include <lib/pmf/pmf.h>
+#include <lib/utils.h>
+#include <plat/common/platform.h>
+
+#if !defined(PLAT_BOOT_INSTR_BASE) || !defined(PLAT_BOOT_INSTR_SIZE)
+# error Platform must define the boot instrumentation log region
+#endif
+
+#define BOOT_INSTR_MAGIC	U(0x4d495442)	/* "BTIM" */
+
+/*
+ * Boot instrumentation log, handed off from one boot image to the next in the
+ * memory region reserved by the platform. The time-stamps are indexed by the
+ * BOOT_INSTR_* ids, and 0 when the corresponding phase hasn't been recorded.
+ */
+typedef struct boot_instr_log {
+	uint32_t magic;
+	uint32_t num_ids;
+	unsigned long long ts[BOOT_INSTR_TOTAL_IDS];
+} boot_instr_log_t;
+
+CASSERT(sizeof(boot_instr_log_t) <= PLAT_BOOT_INSTR_SIZE,
+	assert_boot_instr_log_size);
+CASSERT(BOOT_INSTR_TOTAL_IDS <= PMF_TID_MASK, assert_boot_instr_total_ids);
+
+static boot_instr_log_t *const boot_instr_log =
+	(boot_instr_log_t *)PLAT_BOOT_INSTR_BASE;
+
+/*
+ * The first image of the boot flow starts a new log. The other ones add to
+ * the log of the previous images, unless there isn't any.
+ */
+#if defined(IMAGE_BL1) || (defined(IMAGE_BL2) && BL2_AT_EL3) || \
+	(defined(IMAGE_BL31) && RESET_TO_BL31)
+#define BOOT_INSTR_FIRST_IMAGE	1
+#else
+#define BOOT_INSTR_FIRST_IMAGE	0
+#endif
+
+static unsigned long long boot_instr_entry_ts;
+
+/*
+ * Take the time-stamp of the entry of the current image, before the log region
+ * is mapped.
+ */
+void boot_instr_mark_entry(void)
+{
+	boot_instr_entry_ts = read_cntpct_el0();
+}
+
+/*
+ * Set up the log once its region is mapped, and record the entry time-stamp of
+ * the current image as `tid`.
+ */
+void boot_instr_setup(unsigned int tid)
+{
+	if ((BOOT_INSTR_FIRST_IMAGE != 0) ||
+	    (boot_instr_log->magic != BOOT_INSTR_MAGIC) ||
+	    (boot_instr_log->num_ids != BOOT_INSTR_TOTAL_IDS)) {
+		zeromem(boot_instr_log, sizeof(*boot_instr_log));
+		boot_instr_log->magic = BOOT_INSTR_MAGIC;
+		boot_instr_log->num_ids = BOOT_INSTR_TOTAL_IDS;
+		flush_dcache_range((uintptr_t)boot_instr_log,
+			sizeof(*boot_instr_log));
+	}
+
+	boot_instr_write(tid, boot_instr_entry_ts);
+}
+
+/*
+ * Record the time-stamp `ts` as `tid`. The log is cleaned to the point of
+ * coherency, as the next image may access it with different attributes.
+ */
+void boot_instr_write(unsigned int tid, unsigned long long ts)
+{
+	if (tid >= BOOT_INSTR_TOTAL_IDS)
+		return;
+
+	boot_instr_log->ts[tid] = ts;
+	flush_dcache_range((uintptr_t)&boot_instr_log->ts[tid],
+		sizeof(unsigned long long));
+}
+
+#if defined(IMAGE_BL31) && ENABLE_PMF
+/*
+ * The boot time-stamps are global to the system, so the same values are
+ * returned for all cpus.
+ */
+static unsigned long long boot_instr_get_ts_by_index(unsigned int tid,
+		unsigned int cpuid, unsigned int flags)
+{
+	unsigned long long *ts_addr;
+
+	tid &= PMF_TID_MASK;
+	assert(tid < BOOT_INSTR_TOTAL_IDS);
+	assert(cpuid < PLATFORM_CORE_COUNT);
+
+	ts_addr = &boot_instr_log->ts[tid];
+	if ((flags & PMF_CACHE_MAINT) != 0U)
+		inv_dcache_range((uintptr_t)ts_addr, sizeof(unsigned long long));
+
+	return *ts_addr;
+}
+
+static unsigned long long boot_instr_get_ts(unsigned int tid,
+		u_register_t mpidr, unsigned int flags)
+{
+	return boot_instr_get_ts_by_index(tid,
+		(unsigned int)plat_core_pos_by_mpidr(mpidr), flags);
+}
+
+PMF_DEFINE_SERVICE_DESC(boot_instr_svc, PMF_ARM_TIF_IMPL_ID,
+	PMF_BOOT_INSTR_SVC_ID, BOOT_INSTR_TOTAL_IDS, NULL,
+	boot_instr_get_ts, boot_instr_get_ts_by_index)
+#endif /* IMAGE_BL31 && ENABLE_PMF */
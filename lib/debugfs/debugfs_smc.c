@@ -11,7 +11,9 @@
 #include <lib/debugfs.h>
 #include <lib/smccc.h>
 #include <lib/spinlock.h>
+#include <lib/utils_def.h>
 #include <lib/xlat_tables/xlat_tables_v2.h>
+#include <plat/common/platform.h>
 #include <smccc_helpers.h>
 
 #define MAX_PATH_LEN	256
@@ -27,6 +29,7 @@
 #define STAT		8
 #define INIT		10
 #define VERSION		11
+#define INIT_SIZE	12
 
 /* This is the virtual address to which we map the NS shared buffer */
 #define DEBUGFS_SHARED_BUF_VIRT		((void *)0x81000000U)
@@ -59,6 +62,24 @@ static spinlock_t debugfs_access_lock;
 
 static bool debugfs_initialized;
 
+/* Size of the NS shared buffer, as negotiated on INIT or INIT_SIZE */
+static size_t debugfs_shared_buf_size;
+
+/* Return true if the command exchanges data through the NS shared buffer */
+static bool debugfs_uses_shared_buf(u_register_t cmd)
+{
+	switch (cmd) {
+	case MOUNT:
+	case OPEN:
+	case READ:
+	case BIND:
+	case STAT:
+		return true;
+	default:
+		return false;
+	}
+}
+
 uintptr_t debugfs_smc_handler(unsigned int smc_fid,
 			      u_register_t cmd,
 			      u_register_t arg2,
@@ -69,6 +90,7 @@ uintptr_t debugfs_smc_handler(unsigned int smc_fid,
 			      u_register_t flags)
 {
 	int64_t smc_ret = DEBUGFS_E_INVALID_PARAMS, smc_resp = 0;
+	size_t size;
 	int ret;
 
 	/* Allow calls from non-secure only */
@@ -91,7 +113,12 @@ uintptr_t debugfs_smc_handler(unsigned int smc_fid,
 
 	spin_lock(&debugfs_access_lock);
 
-	if (debugfs_initialized == true) {
+	if (debugfs_uses_shared_buf(cmd) == true) {
+		if (debugfs_initialized == false) {
+			spin_unlock(&debugfs_access_lock);
+			SMC_RET1(handle, DEBUGFS_E_INVALID_PARAMS);
+		}
+
 		/* Copy NS shared buffer to internal secure location */
 		memcpy(&parms, (void *)DEBUGFS_SHARED_BUF_VIRT,
 		       sizeof(union debugfs_parms));
@@ -108,12 +135,44 @@ uintptr_t debugfs_smc_handler(unsigned int smc_fid,
 				MT_MEMORY | MT_RW | MT_NS);
 			if (ret == 0) {
 				debugfs_initialized = true;
+				debugfs_shared_buf_size = PAGE_SIZE_4KB;
 				smc_ret = SMC_OK;
 				smc_resp = 0;
 			}
 		}
 		break;
 
+	case INIT_SIZE:
+		if (debugfs_initialized == false) {
+			/* Map up to the size in x3, capped to the maximum */
+			size = round_down(arg3, PAGE_SIZE_4KB);
+			if (size > PLAT_DEBUGFS_SHARED_BUF_MAX_SIZE) {
+				size = PLAT_DEBUGFS_SHARED_BUF_MAX_SIZE;
+			}
+			if (size == 0U) {
+				break;
+			}
+
+			/* The buffer must be page aligned and lie within */
+			/* Non-secure memory.                             */
+			if (((arg2 & (PAGE_SIZE_4KB - 1U)) != 0U) ||
+			    (plat_validate_ns_buffer(arg2, size) != 0)) {
+				break;
+			}
+
+			ret = mmap_add_dynamic_region(arg2,
+				(uintptr_t)DEBUGFS_SHARED_BUF_VIRT,
+				size,
+				MT_MEMORY | MT_RW | MT_NS);
+			if (ret == 0) {
+				debugfs_initialized = true;
+				debugfs_shared_buf_size = size;
+				smc_ret = SMC_OK;
+				smc_resp = size;
+			}
+		}
+		break;
+
 	case VERSION:
 		smc_ret = SMC_OK;
 		smc_resp = DEBUGFS_VERSION;
@@ -146,7 +205,12 @@ uintptr_t debugfs_smc_handler(unsigned int smc_fid,
 		break;
 
 	case READ:
-		ret = read(arg2, DEBUGFS_SHARED_BUF_VIRT, arg3);
+		/* Fill as much of the shared buffer as requested */
+		if (arg3 > debugfs_shared_buf_size) {
+			arg3 = debugfs_shared_buf_size;
+		}
+
+		ret = readn(arg2, DEBUGFS_SHARED_BUF_VIRT, arg3);
 		if (ret >= 0) {
 			smc_ret = SMC_OK;
 			smc_resp = ret;
@@ -203,6 +267,7 @@ uintptr_t debugfs_smc_handler(unsigned int smc_fid,
 int debugfs_smc_setup(void)
 {
 	debugfs_initialized = false;
+	debugfs_shared_buf_size = 0U;
 	debugfs_access_lock.lock = 0;
 
 	return 0;
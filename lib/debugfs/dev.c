@@ -621,6 +621,48 @@ int read(int fd, void *buf, int n)
 	return devtab[channel->index]->read(channel, buf, n);
 }
 
+/*******************************************************************************
+ * This function fills buf with n bytes of the file associated to fd, calling
+ * the read function of the driver as many times as needed, unless the end of
+ * the file is reached first. Directories are read one element at a time, as
+ * with read().
+ * It returns the number of bytes that were actually read.
+ ******************************************************************************/
+int readn(int fd, void *buf, int n)
+{
+	chan_t *channel;
+	char *cursor = buf;
+	int r;
+
+	if (buf == NULL) {
+		return -1;
+	}
+
+	channel = fd_to_channel(fd);
+	if (channel == NULL) {
+		return -1;
+	}
+
+	if ((channel->qid & CHDIR) != 0) {
+		return read(fd, buf, n);
+	}
+
+	while (n > 0) {
+		r = devtab[channel->index]->read(channel, cursor, n);
+		if (r < 0) {
+			return (cursor == buf) ? r : (cursor - (char *)buf);
+		}
+		if (r == 0) {
+			break;
+		}
+
+		cursor += r;
+		n -= r;
+	}
+
+	return cursor - (char *)buf;
+}
+
 /*******************************************************************************
  * This function calls the write function of the driver associated to fd.
  * It writes at most n bytes of buf.
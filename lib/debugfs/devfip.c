@@ -18,10 +18,15 @@
 #define STOC_HEADER	(sizeof(fip_toc_header_t))
 #define STOC_ENTRY	(sizeof(fip_toc_entry_t))
 
+/*******************************************************************************
+ * This structure caches the ToC of a FIP, which is parsed once at mount time,
+ * so that directory walks don't read the ToC again for each entry.
+ ******************************************************************************/
 struct fipfile {
-	chan_t	*c;
-	long	offset[NR_FILES];
-	long	size[NR_FILES];
+	chan_t		*c;
+	long		offset[NR_FILES];
+	long		size[NR_FILES];
+	const char	*name[NR_FILES];
 };
 
 struct fip_entry {
@@ -114,57 +119,42 @@ static int get_entry(chan_t *c, struct fip_entry *entry)
 }
 
 /*******************************************************************************
- * This function exposes the FIP images as files.
+ * This function returns the file name of a FIP image from its UUID.
  ******************************************************************************/
-static int fipgen(chan_t *c, const dirtab_t *tab, int ntab, int n, dir_t *dir)
+static const char *uuid_to_name(const uuid_t *uuid)
 {
-	int i, r;
-	long off;
-	chan_t nc;
-	struct fip_entry entry;
-	struct fipfile *fip;
+	int i;
 	static const char unk[] = "unknown";
 
-	if (c->dev >= nfips) {
-		panic();
-	}
-
-	clone(archives[c->dev].c, &nc);
-	fip = &archives[nc.dev];
-
-	off = STOC_HEADER;
-	for (i = 0; i <= n; i++) {
-		if (fip->offset[i] == -1) {
-			return 0;
+	for (i = 1; i < NELEM(uuidnames); i++) {
+		if (memcmp(&uuidnames[i].uuid, uuid, sizeof(uuid_t)) == 0) {
+			return uuidnames[i].name;
 		}
+	}
 
-		if (devtab[nc.index]->seek(&nc, off, KSEEK_SET) < 0) {
-			return -1;
-		}
+	// TODO: set name depending on uuid node value
+	return unk;
+}
 
-		r = get_entry(&nc, &entry);
-		if (r <= 0) {
-			return r;
-		}
+/*******************************************************************************
+ * This function exposes the FIP images as files, from the cached ToC.
+ ******************************************************************************/
+static int fipgen(chan_t *c, const dirtab_t *tab, int ntab, int n, dir_t *dir)
+{
+	struct fipfile *fip;
 
-		off += sizeof(entry);
+	if (c->dev >= nfips) {
+		panic();
 	}
 
-	for (i = 1; i < NELEM(uuidnames); i++) {
-		if (memcmp(&uuidnames[i].uuid,
-			   &entry.uuid, sizeof(uuid_t)) == 0) {
-			break;
-		}
-	}
+	fip = &archives[c->dev];
 
-	if (i < NELEM(uuidnames)) {
-		make_dir_entry(c, dir, uuidnames[i].name,
-			       entry.size, n, O_READ);
-	} else {
-		// TODO: set name depending on uuid node value
-		make_dir_entry(c, dir, unk, entry.size, n, O_READ);
+	if ((n < 0) || (n >= NR_FILES) || (fip->offset[n] == -1)) {
+		return 0;
 	}
 
+	make_dir_entry(c, dir, fip->name[n], fip->size[n], n, O_READ);
+
 	return 1;
 }
 
@@ -293,6 +283,7 @@ static chan_t *fipmount(chan_t *c, const char *spec)
 
 			fip->offset[n] = entry.offset_address;
 			fip->size[n] = entry.size;
+			fip->name[n] = uuid_to_name(&entry.uuid);
 			break;
 		}
 	}
@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2020, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Sampling profiler of the time spent in EL3. The PMU cycle counter of a CPU
+ * is set to count the cycles spent in EL3 only, and to raise its overflow
+ * interrupt every `period` cycles. The interrupt is a Group 0 interrupt of the
+ * CPU while sampling. The profiler arms the CPU in its cpu_data, and
+ * smc_handler64 then runs the SMC handlers with FIQs unmasked, so that the
+ * interrupt is taken in EL3 and the interrupted address is recorded in the
+ * histogram of the CPU. Overflows while FIQs are masked are taken from the
+ * lower EL through the EHF once EL3 is exited, and are only counted as
+ * unattributed samples.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <platform_def.h>
+
+#include <arch.h>
+#include <arch_helpers.h>
+#include <bl31/ehf.h>
+#include <bl31/interrupt_mgmt.h>
+#include <common/bl_common.h>
+#include <common/debug.h>
+#include <common/runtime_svc.h>
+#include <context.h>
+#include <drivers/arm/gic_common.h>
+#include <lib/el3_prof.h>
+#include <lib/el3_runtime/context_mgmt.h>
+#include <lib/el3_runtime/cpu_data.h>
+#include <lib/utils_def.h>
+#include <lib/xlat_tables/xlat_tables_v2.h>
+#include <plat/common/platform.h>
+#include <smccc_helpers.h>
+
+#if !PLAT_XLAT_TABLES_DYNAMIC
+#error "ENABLE_EL3_PROF requires PLAT_XLAT_TABLES_DYNAMIC"
+#endif
+
+#if !defined(PLAT_EL3_PROF_PRI) || !defined(PLAT_EL3_PROF_PMU_IRQ)
+#error "ENABLE_EL3_PROF isn't supported by this platform"
+#endif
+
+/* Minimum sampling period, in cycles, to keep the sampling overhead bounded */
+#define EL3_PROF_MIN_PERIOD	U(1000)
+
+/* Count cycles in EL3 only */
+#define EL3_PROF_PMCCFILTR	(PMCCFILTR_EL0_P_BIT | PMCCFILTR_EL0_U_BIT | \
+				 PMCCFILTR_EL0_M_BIT)
+
+/*
+ * Profiling state of a CPU. It is only written by the CPU it belongs to, and
+ * kept in separate cache lines.
+ */
+typedef struct el3_prof_cpu {
+	uint64_t period;
+	bool running;
+
+	/* State of the PMU and of its interrupt before sampling started */
+	u_register_t mdcr_el3;
+	u_register_t pmcr_el0;
+	u_register_t pmccfiltr_el0;
+	u_register_t pmccntr_el0;
+	u_register_t pmcntenset_el0;
+	u_register_t pmintenset_el1;
+	u_register_t pmovsset_el0;
+	uint32_t irq_type;
+
+	uint32_t unattributed;		/* Samples outside of the histogram */
+	uint32_t buckets[PLAT_EL3_PROF_BUCKETS];
+} __aligned(CACHE_WRITEBACK_GRANULE) el3_prof_cpu_t;
+
+static el3_prof_cpu_t el3_prof_cpus[PLATFORM_CORE_COUNT];
+
+static el3_prof_cpu_t *this_cpu_prof(void)
+{
+	return &el3_prof_cpus[plat_my_core_pos()];
+}
+
+/* Clear the overflow and reload the cycle counter for the next sample */
+static void el3_prof_rearm(const el3_prof_cpu_t *prof)
+{
+	write_pmovsclr_el0(PMU_CYCLE_CNT_BIT);
+	write_pmccntr_el0(0ULL - prof->period);
+}
+
+static void el3_prof_start(el3_prof_cpu_t *prof, uint64_t period)
+{
+	cpu_context_t *ns_ctx = cm_get_context(NON_SECURE);
+	u_register_t pmcr;
+
+	if (prof->running)
+		el3_prof_stop();
+
+	(void)memset(prof->buckets, 0, sizeof(prof->buckets));
+	prof->unattributed = 0U;
+	prof->period = period;
+
+	/*
+	 * Save the PMU state of the Non-secure world. Unless Secure cycle
+	 * counting is prohibited, its PMCR_EL0 was saved in its context on
+	 * entry to EL3.
+	 */
+	prof->mdcr_el3 = read_mdcr_el3();
+	if ((prof->mdcr_el3 & MDCR_SCCD_BIT) != 0U) {
+		prof->pmcr_el0 = read_pmcr_el0();
+	} else {
+		prof->pmcr_el0 = read_ctx_reg(get_el3state_ctx(ns_ctx),
+					      CTX_PMCR_EL0);
+	}
+	prof->pmcntenset_el0 = read_pmcntenset_el0() & PMU_CYCLE_CNT_BIT;
+	write_pmcntenclr_el0(PMU_CYCLE_CNT_BIT);
+	prof->pmccfiltr_el0 = read_pmccfiltr_el0();
+	prof->pmccntr_el0 = read_pmccntr_el0();
+	prof->pmovsset_el0 = read_pmovsset_el0() & PMU_CYCLE_CNT_BIT;
+	prof->pmintenset_el1 = read_pmintenset_el1();
+
+	/*
+	 * The PMU interrupt becomes an EL3 interrupt of this CPU for the time
+	 * of sampling. The other overflow interrupts are disabled meanwhile.
+	 */
+	prof->irq_type = plat_ic_get_interrupt_type(PLAT_EL3_PROF_PMU_IRQ);
+	plat_ic_disable_interrupt(PLAT_EL3_PROF_PMU_IRQ);
+	plat_ic_set_interrupt_type(PLAT_EL3_PROF_PMU_IRQ, INTR_TYPE_EL3);
+	plat_ic_set_interrupt_priority(PLAT_EL3_PROF_PMU_IRQ,
+				       PLAT_EL3_PROF_PRI);
+	write_pmintenclr_el1(prof->pmintenset_el1);
+
+	write_pmccfiltr_el0(EL3_PROF_PMCCFILTR);
+	el3_prof_rearm(prof);
+
+	/*
+	 * Allow counting in Secure state, which includes EL3, and make the
+	 * cycle counter count on 64 bits. PMCR_EL0 is restored from the
+	 * Non-secure context on exit from EL3 when Secure cycle counting is
+	 * allowed, so the saved value is updated as well.
+	 */
+	write_mdcr_el3((prof->mdcr_el3 | MDCR_SPME_BIT) & ~MDCR_SCCD_BIT);
+
+	pmcr = (prof->pmcr_el0 | PMCR_EL0_LC_BIT | PMCR_EL0_E_BIT) &
+		~PMCR_EL0_DP_BIT;
+	write_pmcr_el0(pmcr);
+	write_ctx_reg(get_el3state_ctx(ns_ctx), CTX_PMCR_EL0, pmcr);
+
+	prof->running = true;
+	write_pmintenset_el1(PMU_CYCLE_CNT_BIT);
+	write_pmcntenset_el0(PMU_CYCLE_CNT_BIT);
+	isb();
+
+	plat_ic_enable_interrupt(PLAT_EL3_PROF_PMU_IRQ);
+
+	/* Let smc_handler64 unmask FIQs from the next SMC on */
+	set_cpu_data(el3_prof_armed, 1U);
+}
+
+/*
+ * Stop sampling on the calling CPU, and restore the PMU state of the
+ * Non-secure world. This is also called before the CPU is powered down, and
+ * masks FIQs so that none is taken in EL3 from then on.
+ */
+void el3_prof_stop(void)
+{
+	el3_prof_cpu_t *prof = this_cpu_prof();
+
+	disable_fiq();
+	set_cpu_data(el3_prof_armed, 0U);
+
+	if (!prof->running)
+		return;
+
+	/*
+	 * The priority of the interrupt can't be read back, so it is left at
+	 * the default Non-secure priority, and disabled.
+	 */
+	plat_ic_disable_interrupt(PLAT_EL3_PROF_PMU_IRQ);
+	plat_ic_set_interrupt_priority(PLAT_EL3_PROF_PMU_IRQ,
+				       GIC_HIGHEST_NS_PRIORITY);
+	plat_ic_set_interrupt_type(PLAT_EL3_PROF_PMU_IRQ, prof->irq_type);
+
+	write_pmintenclr_el1(PMU_CYCLE_CNT_BIT);
+	write_pmcntenclr_el0(PMU_CYCLE_CNT_BIT);
+	write_pmovsclr_el0(PMU_CYCLE_CNT_BIT);
+
+	write_pmccfiltr_el0(prof->pmccfiltr_el0);
+	write_pmccntr_el0(prof->pmccntr_el0);
+	write_pmovsset_el0(prof->pmovsset_el0);
+	write_pmintenset_el1(prof->pmintenset_el1);
+	write_pmcntenset_el0(prof->pmcntenset_el0);
+
+	/*
+	 * Once MDCR_EL3 is restored, PMCR_EL0 is only restored from the
+	 * Non-secure context on exit from EL3 if Secure cycle counting was
+	 * allowed before sampling started.
+	 */
+	if ((prof->mdcr_el3 & MDCR_SCCD_BIT) != 0U) {
+		write_pmcr_el0(prof->pmcr_el0);
+	} else {
+		write_ctx_reg(get_el3state_ctx(cm_get_context(NON_SECURE)),
+			      CTX_PMCR_EL0, prof->pmcr_el0);
+	}
+	write_mdcr_el3(prof->mdcr_el3);
+	isb();
+
+	prof->running = false;
+}
+
+/*
+ * Handle a FIQ taken in EL3 at address `elr`, while an SMC handler runs with
+ * FIQs unmasked. Returns 1 if FIQs can stay unmasked, or 0 if the interrupt
+ * is not the one of the profiler and must be left to the lower EL exception
+ * path.
+ */
+int el3_prof_handle_fiq(u_register_t elr)
+{
+	el3_prof_cpu_t *prof = this_cpu_prof();
+	uint32_t intr_raw;
+	unsigned int intr;
+	u_register_t idx;
+
+	if (!prof->running ||
+	    (plat_ic_get_pending_interrupt_id() != PLAT_EL3_PROF_PMU_IRQ))
+		return 0;
+
+	intr_raw = plat_ic_acknowledge_interrupt();
+	intr = plat_ic_get_interrupt_id(intr_raw);
+	if (intr == INTR_ID_UNAVAILABLE)
+		return 0;
+
+	if (intr != PLAT_EL3_PROF_PMU_IRQ) {
+		/* Another interrupt won the race; hand it back to the GIC */
+		plat_ic_set_interrupt_pending(intr);
+		plat_ic_end_of_interrupt(intr_raw);
+		return 0;
+	}
+
+	/* Addresses below BL_CODE_BASE wrap around past the last bucket */
+	idx = (elr - BL_CODE_BASE) >> PLAT_EL3_PROF_BUCKET_SHIFT;
+	if (idx < PLAT_EL3_PROF_BUCKETS)
+		prof->buckets[idx]++;
+	else
+		prof->unattributed++;
+
+	el3_prof_rearm(prof);
+	plat_ic_end_of_interrupt(intr_raw);
+
+	return 1;
+}
+
+/*
+ * Handler of the PMU overflow interrupt taken from a lower EL. The overflow
+ * happened in EL3 while FIQs were masked, so the sample has no address.
+ */
+static int el3_prof_interrupt_handler(uint32_t intr_raw, uint32_t flags,
+		void *handle, void *cookie)
+{
+	el3_prof_cpu_t *prof = this_cpu_prof();
+
+	assert(plat_ic_get_interrupt_id(intr_raw) == PLAT_EL3_PROF_PMU_IRQ);
+
+	if (prof->running &&
+	    ((read_pmovsset_el0() & PMU_CYCLE_CNT_BIT) != 0U)) {
+		prof->unattributed++;
+		el3_prof_rearm(prof);
+	}
+
+	plat_ic_end_of_interrupt(intr_raw);
+
+	return 0;
+}
+
+/* Copy the histogram of the CPU `cpu_idx` to the Non-secure buffer at `pa` */
+static int el3_prof_read(unsigned int cpu_idx, unsigned long long pa,
+			 size_t size)
+{
+	const el3_prof_cpu_t *prof = &el3_prof_cpus[cpu_idx];
+	unsigned long long map_pa;
+	uintptr_t map_va;
+	size_t map_size;
+	int rc;
+
+	if ((size < sizeof(prof->buckets)) ||
+	    ((pa + sizeof(prof->buckets)) < pa) ||
+	    ((pa & (sizeof(uint32_t) - 1U)) != 0ULL))
+		return -EINVAL;
+
+	map_pa = round_down(pa, PAGE_SIZE);
+	map_size = (size_t)(round_up(pa + sizeof(prof->buckets), PAGE_SIZE) -
+			    map_pa);
+
+	if (plat_validate_ns_buffer(map_pa, map_size) != 0)
+		return -EINVAL;
+
+	rc = mmap_add_dynamic_region_alloc_va(map_pa, &map_va, map_size,
+			MT_MEMORY | MT_RW | MT_NS);
+	if (rc == 0) {
+		(void)memcpy((void *)(map_va + (uintptr_t)(pa - map_pa)),
+			     prof->buckets, sizeof(prof->buckets));
+
+		rc = mmap_remove_dynamic_region(map_va, map_size);
+		assert(rc == 0);
+	}
+
+	return rc;
+}
+
+/*
+ * This function handles the EL3 profiler SMC calls, which are only available
+ * to the Non-secure world.
+ */
+uintptr_t el3_prof_smc_handler(unsigned int smc_fid,
+		u_register_t x1,
+		u_register_t x2,
+		u_register_t x3,
+		u_register_t x4,
+		void *cookie,
+		void *handle,
+		u_register_t flags)
+{
+	int cpu_idx;
+	int rc;
+
+	if (!is_caller_non_secure(flags))
+		SMC_RET1(handle, SMC_UNK);
+
+	switch (smc_fid) {
+	case EL3_PROF_SMC_START_64:
+		if (x1 < EL3_PROF_MIN_PERIOD)
+			SMC_RET1(handle, -EINVAL);
+
+		el3_prof_start(this_cpu_prof(), x1);
+		SMC_RET1(handle, SMC_OK);
+
+	case EL3_PROF_SMC_STOP_64:
+		el3_prof_stop();
+		SMC_RET1(handle, SMC_OK);
+
+	case EL3_PROF_SMC_READ_64:
+		cpu_idx = plat_core_pos_by_mpidr(x1);
+		if (cpu_idx < 0)
+			SMC_RET1(handle, -EINVAL);
+
+		rc = el3_prof_read((unsigned int)cpu_idx, x2, (size_t)x3);
+		if (rc != 0)
+			SMC_RET1(handle, rc);
+
+		SMC_RET5(handle, SMC_OK, BL_CODE_BASE,
+			 PLAT_EL3_PROF_BUCKET_SHIFT, PLAT_EL3_PROF_BUCKETS,
+			 el3_prof_cpus[cpu_idx].unattributed);
+
+	default:
+		WARN("Unimplemented EL3 profiler Call: 0x%x\n", smc_fid);
+		SMC_RET1(handle, SMC_UNK);
+	}
+}
+
+void __init el3_prof_init(void)
+{
+	ehf_register_priority_handler(PLAT_EL3_PROF_PRI,
+				      el3_prof_interrupt_handler);
+}
@@ -618,6 +618,46 @@ void cm_el2_sysregs_context_restore(uint32_t security_state)
 }
 #endif /* CTX_INCLUDE_EL2_REGS */
 
+#if CTX_LAZY_SYSREGS
+/*******************************************************************************
+ * Optional groups of EL1 system registers that are switched separately when
+ * CTX_LAZY_SYSREGS is enabled.
+ ******************************************************************************/
+#define CTX_SYSREGS_GROUP_AARCH32	(U(1) << 0)
+
+/*******************************************************************************
+ * This function returns the optional groups of EL1 system registers that the
+ * lower ELs of the security state owning 'ctx' are able to access, based on
+ * the SCR_EL3 value programmed in the context:
+ *
+ * - The AArch32 registers are only accessible if EL1 is using AArch32 or if
+ *   EL2 is in use in this security state.
+ *
+ * A group that is not accessible by a security state cannot be read nor
+ * modified by it, so it does not need to be saved when leaving this security
+ * state nor restored when entering it. Its registers keep the values of the
+ * last security state that was able to access them, which is never exposed.
+ ******************************************************************************/
+static unsigned int cm_get_sysregs_groups(uint32_t security_state,
+					  const cpu_context_t *ctx)
+{
+	unsigned int groups = 0U;
+	u_register_t scr_el3 = read_ctx_reg(get_el3state_ctx(ctx),
+					    CTX_SCR_EL3);
+	bool el2_used;
+
+	if (security_state == SECURE)
+		el2_used = (scr_el3 & SCR_EEL2_BIT) != 0U;
+	else
+		el2_used = el_implemented(2U) != EL_IMPL_NONE;
+
+	if (((scr_el3 & SCR_RW_BIT) == 0U) || el2_used)
+		groups |= CTX_SYSREGS_GROUP_AARCH32;
+
+	return groups;
+}
+#endif /* CTX_LAZY_SYSREGS */
+
 /*******************************************************************************
  * The next four functions are used by runtime services to save and restore
  * EL1 context on the 'cpu_context' structure for the specified security
@@ -632,6 +672,16 @@ void cm_el1_sysregs_context_save(uint32_t security_state)
 
 	el1_sysregs_context_save(get_el1_sysregs_ctx(ctx));
 
+#if CTX_LAZY_SYSREGS
+	unsigned int groups = cm_get_sysregs_groups(security_state, ctx);
+
+#if CTX_INCLUDE_AARCH32_REGS
+	if ((groups & CTX_SYSREGS_GROUP_AARCH32) != 0U)
+		el1_aarch32_sysregs_context_save(get_el1_sysregs_ctx(ctx));
+#endif
+	(void)groups;
+#endif /* CTX_LAZY_SYSREGS */
+
 #if IMAGE_BL31
 	if (security_state == SECURE)
 		PUBLISH_EVENT(cm_exited_secure_world);
@@ -649,6 +699,16 @@ void cm_el1_sysregs_context_restore(uint32_t security_state)
 
 	el1_sysregs_context_restore(get_el1_sysregs_ctx(ctx));
 
+#if CTX_LAZY_SYSREGS
+	unsigned int groups = cm_get_sysregs_groups(security_state, ctx);
+
+#if CTX_INCLUDE_AARCH32_REGS
+	if ((groups & CTX_SYSREGS_GROUP_AARCH32) != 0U)
+		el1_aarch32_sysregs_context_restore(get_el1_sysregs_ctx(ctx));
+#endif
+	(void)groups;
+#endif /* CTX_LAZY_SYSREGS */
+
 #if IMAGE_BL31
 	if (security_state == SECURE)
 		PUBLISH_EVENT(cm_entering_secure_world);
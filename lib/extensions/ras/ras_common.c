@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2020, ARM Limited and Contributors. All rights reserved.
  * Copyright (c) 2020, NVIDIA Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -11,14 +11,53 @@
 #include <bl31/ea_handle.h>
 #include <bl31/ehf.h>
 #include <common/debug.h>
+#include <lib/cassert.h>
 #include <lib/extensions/ras.h>
 #include <lib/extensions/ras_arch.h>
+#include <lib/spinlock.h>
 #include <plat/common/platform.h>
 
 #ifndef PLAT_RAS_PRI
 # error Platform must define RAS priority value
 #endif
 
+/*
+ * Maximum number of errors handled from a record group for one RAS interrupt.
+ * Remaining errors keep the interrupt asserted, and are handled when it's taken
+ * again, so that an error storm doesn't hold the PE in EL3 indefinitely.
+ */
+#ifndef PLAT_RAS_MAX_ERR_PER_INTR
+# define PLAT_RAS_MAX_ERR_PER_INTR	16U
+#endif
+
+/* Length of the window over which errors of a record group are accounted */
+#ifndef PLAT_RAS_ERR_WINDOW_MS
+# define PLAT_RAS_ERR_WINDOW_MS		1000U
+#endif
+
+/*
+ * Number of errors of a record group in one window from which the group is
+ * reported as being in an error storm. The report is made once per window.
+ */
+#ifndef PLAT_RAS_ERR_STORM_THRESHOLD
+# define PLAT_RAS_ERR_STORM_THRESHOLD	64U
+#endif
+
+/* Number of corrected errors of a record group coalesced into one escalation */
+#ifndef PLAT_RAS_CE_THRESHOLD
+# define PLAT_RAS_CE_THRESHOLD		1U
+#endif
+
+/* Minimum interval between two escalations of a record group */
+#ifndef PLAT_RAS_CE_MIN_INTERVAL_MS
+# define PLAT_RAS_CE_MIN_INTERVAL_MS	0U
+#endif
+
+CASSERT(PLAT_RAS_MAX_ERR_PER_INTR > 0U, assert_ras_max_err_per_intr_non_zero);
+CASSERT(PLAT_RAS_CE_THRESHOLD > 0U, assert_ras_ce_threshold_non_zero);
+
+static spinlock_t ras_stat_lock;
+
 /*
  * Function to convert architecturally-defined primary error code SERR,
  * bits[7:0] from ERR<n>STATUS to its corresponding error string.
@@ -60,6 +99,89 @@ const char *ras_serr_to_str(unsigned int serr)
 	return str[serr];
 }
 
+static inline uint64_t ras_ms_to_ticks(unsigned int ms)
+{
+	return (read_cntfrq_el0() * ms) / 1000U;
+}
+
+static struct err_record_stat *ras_err_record_stat(
+		const struct err_record_info *info)
+{
+	size_t idx = (size_t) (info - err_record_mappings.err_records);
+
+	assert(idx < err_record_mappings.num_err_records);
+
+	return &err_record_mappings.stats[idx];
+}
+
+/* Account an error handled from a record group */
+static void ras_err_record_account(const struct err_record_info *info)
+{
+	struct err_record_stat *stat = ras_err_record_stat(info);
+	uint64_t now = read_cntpct_el0();
+	bool storm;
+
+	spin_lock(&ras_stat_lock);
+
+	stat->count++;
+
+	if ((now - stat->window_start) >=
+			ras_ms_to_ticks(PLAT_RAS_ERR_WINDOW_MS)) {
+		stat->window_start = now;
+		stat->window_count = 0U;
+	}
+
+	stat->window_count++;
+	storm = (stat->window_count == PLAT_RAS_ERR_STORM_THRESHOLD);
+
+	spin_unlock(&ras_stat_lock);
+
+	/* Rate-limit the report to once per window */
+	if (storm) {
+		WARN("RAS: error storm on record group %lu (%u errors in %ums)\n",
+			(unsigned long) (info - err_record_mappings.err_records),
+			PLAT_RAS_ERR_STORM_THRESHOLD, PLAT_RAS_ERR_WINDOW_MS);
+	}
+}
+
+/* Return the total number of errors handled from a record group */
+uint64_t ras_err_record_count(const struct err_record_info *info)
+{
+	return ras_err_record_stat(info)->count;
+}
+
+/*
+ * Coalesce a corrected error of a record group before it's escalated, e.g. to
+ * Normal world through SDEI. Error handlers call this for each corrected error
+ * they handle. It returns the number of corrected errors to report if the
+ * escalation is due, or 0 if it must be deferred: at least
+ * PLAT_RAS_CE_THRESHOLD errors must have been coalesced, and at least
+ * PLAT_RAS_CE_MIN_INTERVAL_MS must have elapsed since the last escalation.
+ */
+unsigned int ras_err_ce_coalesce(const struct err_record_info *info)
+{
+	struct err_record_stat *stat = ras_err_record_stat(info);
+	uint64_t now = read_cntpct_el0();
+	unsigned int ret = 0U;
+
+	spin_lock(&ras_stat_lock);
+
+	stat->ce_pending++;
+
+	if ((stat->ce_pending >= PLAT_RAS_CE_THRESHOLD) &&
+			((stat->last_escalation == 0ULL) ||
+			 ((now - stat->last_escalation) >=
+			  ras_ms_to_ticks(PLAT_RAS_CE_MIN_INTERVAL_MS)))) {
+		ret = stat->ce_pending;
+		stat->ce_pending = 0U;
+		stat->last_escalation = now;
+	}
+
+	spin_unlock(&ras_stat_lock);
+
+	return ret;
+}
+
 /* Handler that receives External Aborts on RAS-capable systems */
 int ras_ea_handler(unsigned int ea_reason, uint64_t syndrome, void *cookie,
 		void *handle, uint64_t flags)
@@ -92,6 +214,7 @@ int ras_ea_handler(unsigned int ea_reason, uint64_t syndrome, void *cookie,
 			if (ret != 0)
 				return ret;
 
+			ras_err_record_account(info);
 			n_handled++;
 		}
 	}
@@ -125,8 +248,10 @@ static int ras_interrupt_handler(uint32_t intr_raw, uint32_t flags,
 {
 	struct ras_interrupt *ras_inrs = ras_interrupt_mappings.intrs;
 	struct ras_interrupt *selected = NULL;
+	const struct err_record_info *info;
 	int probe_data = 0;
-	int start, end, mid, ret __unused;
+	int start, end, mid, ret;
+	unsigned int n_handled;
 
 	const struct err_handler_data err_data = {
 		.version = ERR_HANDLER_VERSION,
@@ -139,7 +264,7 @@ static int ras_interrupt_handler(uint32_t intr_raw, uint32_t flags,
 	assert(ras_interrupt_mappings.num_intrs > 0UL);
 
 	start = 0;
-	end = (int) ras_interrupt_mappings.num_intrs;
+	end = (int) ras_interrupt_mappings.num_intrs - 1;
 	while (start <= end) {
 		mid = ((end + start) / 2);
 		if (intr_raw == ras_inrs[mid].intr_number) {
@@ -159,15 +284,40 @@ static int ras_interrupt_handler(uint32_t intr_raw, uint32_t flags,
 		panic();
 	}
 
-	if (selected->err_record->probe != NULL) {
-		ret = selected->err_record->probe(selected->err_record, &probe_data);
-		assert(ret != 0);
+	info = selected->err_record;
+	assert(info->handler != NULL);
+
+	/* Without a probe, the handler deals with the whole record group */
+	if (info->probe == NULL) {
+		(void) info->handler(info, probe_data, &err_data);
+		ras_err_record_account(info);
+		return 0;
 	}
 
-	/* Call error handler for the record group */
-	assert(selected->err_record->handler != NULL);
-	(void) selected->err_record->handler(selected->err_record, probe_data,
-			&err_data);
+	/*
+	 * Handle all the errors pending in the record group in one pass, rather
+	 * than taking the interrupt again for each of them. This is bounded by
+	 * PLAT_RAS_MAX_ERR_PER_INTR; errors left over keep the interrupt
+	 * asserted. If the handler fails, the error is likely still pending in
+	 * the record, so stop rather than probing and accounting it again.
+	 */
+	for (n_handled = 0U; n_handled < PLAT_RAS_MAX_ERR_PER_INTR;
+			n_handled++) {
+		if (info->probe(info, &probe_data) == 0) {
+			/* The interrupt must have been raised for an error */
+			assert(n_handled != 0U);
+			break;
+		}
+
+		ret = info->handler(info, probe_data, &err_data);
+		if (ret != 0) {
+			WARN("RAS interrupt %u: error handler failed (%d)\n",
+					intr_raw, ret);
+			break;
+		}
+
+		ras_err_record_account(info);
+	}
 
 	return 0;
 }
@@ -1,5 +1,5 @@
 #
-# Copyright (c) 2016-2019, ARM Limited and Contributors. All rights reserved.
+# Copyright (c) 2016-2020, ARM Limited and Contributors. All rights reserved.
 #
 # SPDX-License-Identifier: BSD-3-Clause
 #
@@ -15,6 +15,7 @@ LIBC_SRCS	:=	$(addprefix lib/libc/,		\
 			memrchr.c			\
 			memset.c			\
 			printf.c			\
+			printf_core.c			\
 			putchar.c			\
 			puts.c				\
 			snprintf.c			\
@@ -14,6 +14,7 @@ LIBC_SRCS	:=	$(addprefix lib/libc/,		\
 			memmove.c			\
 			memrchr.c			\
 			printf.c			\
+			printf_core.c			\
 			putchar.c			\
 			puts.c				\
 			snprintf.c			\
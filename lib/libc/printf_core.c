@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2014-2020, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "printf_core.h"
+
+#define get_num_va_args(_args, _lcount)				\
+	(((_lcount) > 1)  ? va_arg(_args, long long int) :	\
+	(((_lcount) == 1) ? va_arg(_args, long int) :		\
+			    va_arg(_args, int)))
+
+#define get_unum_va_args(_args, _lcount)				\
+	(((_lcount) > 1)  ? va_arg(_args, unsigned long long int) :	\
+	(((_lcount) == 1) ? va_arg(_args, unsigned long int) :		\
+			    va_arg(_args, unsigned int)))
+
+/* Size of the buffer in which characters are formatted before output */
+#define PRINTF_CORE_BUF_SIZE	64U
+
+/* Enough space to store a 64 bit decimal integer */
+#define NUM_BUF_SIZE		20U
+
+typedef struct printf_ctx {
+	printf_core_out_t out;
+	void *cookie;
+	size_t len;
+	int count;
+	char buf[PRINTF_CORE_BUF_SIZE];
+} printf_ctx_t;
+
+static const char lower_digits[] = "0123456789abcdef";
+static const char upper_digits[] = "0123456789ABCDEF";
+
+static void ctx_flush(printf_ctx_t *ctx)
+{
+	if (ctx->len != 0U) {
+		ctx->out(ctx->buf, ctx->len, ctx->cookie);
+		ctx->len = 0U;
+	}
+}
+
+static void ctx_putc(printf_ctx_t *ctx, char c)
+{
+	if (ctx->len == sizeof(ctx->buf))
+		ctx_flush(ctx);
+
+	ctx->buf[ctx->len++] = c;
+	ctx->count++;
+}
+
+static void ctx_write(printf_ctx_t *ctx, const char *str, size_t len)
+{
+	while (len-- > 0U) {
+		ctx_putc(ctx, *str);
+		str++;
+	}
+}
+
+static void ctx_pad(printf_ctx_t *ctx, char padc, int padn)
+{
+	while (padn-- > 0)
+		ctx_putc(ctx, padc);
+}
+
+/* High 64 bits of the 128-bit product of a and b */
+static inline unsigned long long umulh64(unsigned long long a,
+					 unsigned long long b)
+{
+#ifdef __SIZEOF_INT128__
+	return (unsigned long long)(((unsigned __int128)a * b) >> 64);
+#else
+	unsigned long long a_lo = (uint32_t)a, a_hi = a >> 32;
+	unsigned long long b_lo = (uint32_t)b, b_hi = b >> 32;
+	unsigned long long lo_lo = a_lo * b_lo;
+	unsigned long long hi_lo = a_hi * b_lo;
+	unsigned long long lo_hi = a_lo * b_hi;
+	unsigned long long cross;
+
+	cross = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+
+	return (a_hi * b_hi) + (hi_lo >> 32) + (cross >> 32);
+#endif
+}
+
+/*
+ * Write the hexadecimal digits of `unum` backwards from `end` and return a
+ * pointer to the first digit.
+ */
+static char *hex_to_str(unsigned long long unum, char *end,
+			const char *digits)
+{
+	do {
+		*--end = digits[unum & 0xfU];
+		unum >>= 4;
+	} while (unum != 0U);
+
+	return end;
+}
+
+/*
+ * Write the decimal digits of `unum` backwards from `end` and return a pointer
+ * to the first digit. Divisions by 10 are done by multiplying by the
+ * reciprocal of 10, on 64 bits only while the value doesn't fit in 32 bits.
+ */
+static char *dec_to_str(unsigned long long unum, char *end)
+{
+	unsigned long long q;
+	uint32_t n, q32;
+
+	while (unum > UINT32_MAX) {
+		q = umulh64(unum, 0xCCCCCCCCCCCCCCCDULL) >> 3;
+		*--end = (char)('0' + (unsigned int)(unum - (q * 10U)));
+		unum = q;
+	}
+
+	n = (uint32_t)unum;
+	do {
+		q32 = (uint32_t)(((uint64_t)n * 0xCCCCCCCDU) >> 35);
+		*--end = (char)('0' + (n - (q32 * 10U)));
+		n = q32;
+	} while (n != 0U);
+
+	return end;
+}
+
+/* Output a field, padded to `padn` characters */
+static void field_print(printf_ctx_t *ctx, const char *prefix,
+			const char *str, size_t len, char padc, int padn,
+			bool left)
+{
+	size_t prefix_len = strlen(prefix);
+
+	padn -= (int)(prefix_len + len);
+
+	if (left) {
+		ctx_write(ctx, prefix, prefix_len);
+		ctx_write(ctx, str, len);
+		ctx_pad(ctx, ' ', padn);
+	} else if (padc == '0') {
+		ctx_write(ctx, prefix, prefix_len);
+		ctx_pad(ctx, '0', padn);
+		ctx_write(ctx, str, len);
+	} else {
+		ctx_pad(ctx, ' ', padn);
+		ctx_write(ctx, prefix, prefix_len);
+		ctx_write(ctx, str, len);
+	}
+}
+
+/*******************************************************************
+ * Formatting engine shared by the printf family of functions.
+ * The following type specifiers are supported
+ * %x (or %X) - hexadecimal format
+ * %s - string format
+ * %d or %i - signed decimal format
+ * %u - unsigned decimal format
+ * %p - pointer format
+ *
+ * The following length specifiers are supported
+ * %l - long int (64-bit on AArch64)
+ * %ll - long long int (64-bit on AArch64)
+ * %z - size_t sized integer formats (64 bit on AArch64)
+ *
+ * The following padding specifiers are supported
+ * %0NN - Left-pad the number with 0s (NN is a decimal number)
+ * %NN - Left-pad the number or string with spaces (NN is a decimal number)
+ * %-NN - Right-pad the number or string with spaces (NN is a decimal number)
+ *
+ * Characters are formatted in a local buffer, which is passed to the
+ * output callback when it is full and at the end of the string.
+ *******************************************************************/
+int printf_core(printf_core_out_t out, void *cookie, const char *fmt,
+		va_list args)
+{
+	printf_ctx_t ctx;
+	char num_buf[NUM_BUF_SIZE];
+	char *num_end = &num_buf[NUM_BUF_SIZE];
+	const char *prefix;
+	const char *str;
+	size_t len;
+	long long int num;
+	unsigned long long int unum;
+	char padc;	/* Padding character */
+	int padn;	/* Number of characters to pad */
+	int l_count;
+	bool left;
+
+	ctx.out = out;
+	ctx.cookie = cookie;
+	ctx.len = 0U;
+	ctx.count = 0;
+
+	for ( ; *fmt != '\0'; fmt++) {
+		if (*fmt != '%') {
+			ctx_putc(&ctx, *fmt);
+			continue;
+		}
+		fmt++;
+
+		/* Padding specifiers */
+		left = false;
+		padc = ' ';
+		padn = 0;
+
+		if (*fmt == '-') {
+			left = true;
+			fmt++;
+		}
+		if (*fmt == '0') {
+			padc = '0';
+			fmt++;
+		}
+		for ( ; (*fmt >= '0') && (*fmt <= '9'); fmt++)
+			padn = (padn * 10) + (*fmt - '0');
+
+		/* Length specifiers */
+		for (l_count = 0; ; fmt++) {
+			if (*fmt == 'l') {
+				l_count++;
+			} else if (*fmt == 'z') {
+				if (sizeof(size_t) == 8U)
+					l_count = 2;
+			} else {
+				break;
+			}
+		}
+
+		prefix = "";
+
+		switch (*fmt) {
+		case 'i':
+		case 'd':
+			num = get_num_va_args(args, l_count);
+			if (num < 0) {
+				prefix = "-";
+				unum = -(unsigned long long int)num;
+			} else {
+				unum = (unsigned long long int)num;
+			}
+			str = dec_to_str(unum, num_end);
+			break;
+		case 'u':
+			unum = get_unum_va_args(args, l_count);
+			str = dec_to_str(unum, num_end);
+			break;
+		case 'X':
+			unum = get_unum_va_args(args, l_count);
+			str = hex_to_str(unum, num_end, upper_digits);
+			break;
+		case 'x':
+			unum = get_unum_va_args(args, l_count);
+			str = hex_to_str(unum, num_end, lower_digits);
+			break;
+		case 'p':
+			unum = (uintptr_t)va_arg(args, void *);
+			if (unum > 0U)
+				prefix = "0x";
+			str = hex_to_str(unum, num_end, lower_digits);
+			break;
+		case 's':
+			str = va_arg(args, const char *);
+			assert(str != NULL);
+			field_print(&ctx, prefix, str, strlen(str), ' ', padn,
+				    left);
+			continue;
+		default:
+			/* Exit on any other format specifier */
+			ctx_flush(&ctx);
+			return -1;
+		}
+
+		len = (size_t)(num_end - str);
+		field_print(&ctx, prefix, str, len, padc, padn, left);
+	}
+
+	ctx_flush(&ctx);
+
+	return ctx.count;
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2020, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PRINTF_CORE_H
+#define PRINTF_CORE_H
+
+#include <stdarg.h>
+#include <stddef.h>
+
+/*
+ * Output callback of the formatting engine. It is called with consecutive
+ * chunks of the formatted string, which are not NUL-terminated.
+ */
+typedef void (*printf_core_out_t)(const char *buf, size_t len, void *cookie);
+
+/*
+ * Format `fmt` with `args` and pass the result to `out`. It returns the number
+ * of characters formatted, or -1 on an unsupported format specifier, in which
+ * case the characters formatted before it have been passed to `out`.
+ */
+int printf_core(printf_core_out_t out, void *cookie, const char *fmt,
+		va_list args);
+
+#endif /* PRINTF_CORE_H */
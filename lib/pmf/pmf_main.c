@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2020, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -12,7 +12,9 @@
 #include <arch_helpers.h>
 #include <common/debug.h>
 #include <lib/pmf/pmf.h>
+#include <lib/runtime_instr.h>
 #include <lib/utils_def.h>
+#include <lib/xlat_tables/xlat_tables_v2.h>
 #include <plat/common/platform.h>
 
 /*******************************************************************************
@@ -175,6 +177,80 @@ int pmf_get_timestamp_smc(unsigned int tid,
 	}
 }
 
+#if PLAT_XLAT_TABLES_DYNAMIC
+/*
+ * This function copies all the time-stamps of the PMF service identified by
+ * the Service ID in `tid`, for all cpus, to the non-secure buffer at `buf_pa`.
+ * The time-stamps are stored by cpu index, then by local time-stamp id. The
+ * number of time-stamps per cpu is returned in `num_ids`.
+ *
+ * The buffer must lie within Non-secure memory, as reported by the platform,
+ * and is mapped only for the duration of the copy. With the
+ * PMF_CACHE_MAINT flag, the time-stamps are invalidated before being read,
+ * and the buffer is cleaned to the point of coherency once written, for a
+ * caller accessing it with the data cache disabled.
+ */
+int pmf_get_timestamps_smc(unsigned int tid,
+		unsigned long long buf_pa,
+		size_t buf_size,
+		unsigned int flags,
+		unsigned int *num_ids)
+{
+	pmf_svc_desc_t *svc_desc;
+	unsigned long long *buf;
+	unsigned long long map_pa;
+	uintptr_t map_va;
+	size_t size, map_size;
+	unsigned int total_ids, cpuid, ii;
+	int rc;
+
+	assert(num_ids != NULL);
+
+	/* Search for registered service. */
+	svc_desc = get_service(tid & PMF_SVC_ID_MASK);
+	if ((svc_desc == NULL) || (svc_desc->get_ts_by_index == NULL))
+		return -EINVAL;
+
+	total_ids = (svc_desc->svc_config & PMF_TID_MASK) >> PMF_TID_SHIFT;
+	size = (size_t)total_ids * PLATFORM_CORE_COUNT *
+		sizeof(unsigned long long);
+
+	if ((buf_size < size) || ((buf_pa + size) < buf_pa) ||
+	    ((buf_pa & (sizeof(unsigned long long) - 1U)) != 0ULL))
+		return -EINVAL;
+
+	map_pa = round_down(buf_pa, PAGE_SIZE);
+	map_size = (size_t)(round_up(buf_pa + size, PAGE_SIZE) - map_pa);
+
+	if (plat_validate_ns_buffer(map_pa, map_size) != 0)
+		return -EINVAL;
+
+	rc = mmap_add_dynamic_region_alloc_va(map_pa, &map_va, map_size,
+			MT_MEMORY | MT_RW | MT_NS);
+	if (rc == 0) {
+		buf = (unsigned long long *)(map_va + (uintptr_t)(buf_pa - map_pa));
+
+		for (cpuid = 0U; cpuid < PLATFORM_CORE_COUNT; cpuid++) {
+			for (ii = 0U; ii < total_ids; ii++) {
+				buf[(cpuid * total_ids) + ii] =
+					svc_desc->get_ts_by_index(ii, cpuid,
+							flags);
+			}
+		}
+
+		if ((flags & PMF_CACHE_MAINT) != 0U)
+			flush_dcache_range((uintptr_t)buf, size);
+
+		rc = mmap_remove_dynamic_region(map_va, map_size);
+		assert(rc == 0);
+	}
+
+	*num_ids = total_ids;
+
+	return rc;
+}
+#endif /* PLAT_XLAT_TABLES_DYNAMIC */
+
 /*
  * This function can be used to dump `ts` value for given `tid`.
  * Assumption is that the console is already initialized.
@@ -254,3 +330,139 @@ unsigned long long __pmf_get_timestamp(uintptr_t base_addr,
 
 	return *ts_addr;
 }
+
+#if PMF_TRACE
+/*
+ * Number of entries of the per-cpu trace buffers. It must be a power of 2.
+ */
+#ifdef PLAT_PMF_TRACE_ENTRIES
+#define PMF_TRACE_ENTRIES	PLAT_PMF_TRACE_ENTRIES
+#else
+#define PMF_TRACE_ENTRIES	256U
+#endif
+
+CASSERT(IS_POWER_OF_TWO(PMF_TRACE_ENTRIES), assert_pmf_trace_entries_pow2);
+
+/*
+ * Per-cpu trace buffer. `head` is the sequence number of the next entry to be
+ * written, the entry being at index `head % PMF_TRACE_ENTRIES`. Only the
+ * owning cpu writes into its buffer, so no lock is needed: readers check that
+ * the entries they copied haven't been overwritten in the meantime instead.
+ */
+typedef struct pmf_trace_buf {
+	unsigned long long head;
+	pmf_trace_entry_t entries[PMF_TRACE_ENTRIES];
+} __aligned(CACHE_WRITEBACK_GRANULE) pmf_trace_buf_t;
+
+static pmf_trace_buf_t pmf_trace_bufs[PLATFORM_CORE_COUNT];
+
+/*
+ * This function records the `ts` value of the time-stamp `tid`, along with an
+ * event-specific `arg`, in the trace buffer of the current cpu. When the
+ * buffer is full, the oldest entry is overwritten.
+ */
+void __pmf_trace_timestamp(unsigned int tid,
+			unsigned long long ts,
+			unsigned int arg,
+			unsigned int flags)
+{
+	pmf_trace_buf_t *buf = &pmf_trace_bufs[plat_my_core_pos()];
+	unsigned long long seq = buf->head;
+	pmf_trace_entry_t *entry = &buf->entries[seq & (PMF_TRACE_ENTRIES - 1U)];
+
+	/*
+	 * The entry must not be seen updated before the previous head update,
+	 * and the head must not be seen updated before the entry, for readers
+	 * to detect overwritten entries.
+	 */
+	dmbishst();
+	entry->ts = ts;
+	entry->tid = tid;
+	entry->arg = arg;
+	dmbishst();
+	buf->head = seq + 1ULL;
+
+	if ((flags & PMF_CACHE_MAINT) != 0U) {
+		flush_dcache_range((uintptr_t)entry, sizeof(*entry));
+		flush_dcache_range((uintptr_t)&buf->head, sizeof(buf->head));
+	}
+}
+
+static inline unsigned long long pmf_trace_head(const pmf_trace_buf_t *buf)
+{
+	return *(const volatile unsigned long long *)&buf->head;
+}
+
+/*
+ * This function copies up to PMF_TRACE_READ_MAX entries from the trace buffer
+ * of the cpu `mpidr`, starting at sequence number `seq`. If the entry `seq`
+ * has already been overwritten, the copy starts at the oldest entry available
+ * instead. The sequence number of the first entry copied is returned in
+ * `first_seq`, and the number of entries copied as return value, so that the
+ * caller can resume from `first_seq` plus that number. A negative error code
+ * is returned if `mpidr` is invalid.
+ */
+int pmf_trace_read(u_register_t mpidr,
+		unsigned long long seq,
+		pmf_trace_entry_t *entries,
+		unsigned long long *first_seq)
+{
+	const pmf_trace_buf_t *buf;
+	unsigned long long head;
+	unsigned int i, n;
+	int cpuid = plat_core_pos_by_mpidr(mpidr);
+
+	assert((entries != NULL) && (first_seq != NULL));
+
+	if (cpuid < 0)
+		return -EINVAL;
+
+	buf = &pmf_trace_bufs[cpuid];
+
+	do {
+		head = pmf_trace_head(buf);
+		dmbish();
+
+		/*
+		 * The entry at `head - PMF_TRACE_ENTRIES` may be being
+		 * overwritten by the owning cpu, so it isn't returned.
+		 */
+		if (seq > head)
+			seq = head;
+		else if ((head - seq) >= PMF_TRACE_ENTRIES)
+			seq = head - PMF_TRACE_ENTRIES + 1ULL;
+
+		n = (unsigned int)MIN(head - seq,
+				(unsigned long long)PMF_TRACE_READ_MAX);
+		for (i = 0U; i < n; i++) {
+			entries[i] = buf->entries[(seq + i) &
+					(PMF_TRACE_ENTRIES - 1U)];
+		}
+
+		/* Retry if the oldest entry copied was overwritten meanwhile */
+		dmbish();
+		head = pmf_trace_head(buf);
+	} while ((n != 0U) && ((head - seq) >= PMF_TRACE_ENTRIES));
+
+	*first_seq = seq;
+
+	return (int)n;
+}
+
+#if ENABLE_RUNTIME_INSTRUMENTATION
+/*
+ * This function records the current value of the runtime instrumentation
+ * time-stamp `tid` of the current cpu in its trace buffer. It is used for the
+ * time-stamps that are stored from assembly code.
+ */
+void pmf_trace_rt_instr(unsigned int tid, unsigned int arg)
+{
+	unsigned long long ts;
+
+	PMF_GET_TIMESTAMP_BY_INDEX(rt_instr_svc, tid, plat_my_core_pos(),
+		PMF_NO_CACHE_MAINT, ts);
+	__pmf_trace_timestamp(((PMF_RT_INSTR_SVC_ID << PMF_SVC_ID_SHIFT) &
+		PMF_SVC_ID_MASK) | tid, ts, arg, PMF_NO_CACHE_MAINT);
+}
+#endif /* ENABLE_RUNTIME_INSTRUMENTATION */
+#endif /* PMF_TRACE */
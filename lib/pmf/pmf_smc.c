@@ -1,11 +1,13 @@
 /*
- * Copyright (c) 2016-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2020, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
 
+#include <platform_def.h>
+
 #include <common/debug.h>
 #include <lib/pmf/pmf.h>
 #include <plat/common/platform.h>
@@ -56,6 +58,51 @@ uintptr_t pmf_smc_handler(unsigned int smc_fid,
 					(unsigned int)x3, &ts_value);
 			SMC_RET2(handle, rc, ts_value);
 		}
+
+#if PLAT_XLAT_TABLES_DYNAMIC
+		if (smc_fid == PMF_SMC_GET_TIMESTAMPS_64) {
+			unsigned int num_ids = 0U;
+
+			/*
+			 * Copy all the time-stamps of the service of `x1`
+			 * to the non-secure buffer at `x2` of size `x3`.
+			 * x0 --> error code.
+			 * x1 --> number of time-stamps per cpu.
+			 * x2 --> number of cpus.
+			 */
+			rc = pmf_get_timestamps_smc((unsigned int)x1, x2,
+					(size_t)x3, (unsigned int)x4, &num_ids);
+			SMC_RET3(handle, rc, num_ids, PLATFORM_CORE_COUNT);
+		}
+#endif
+
+#if PMF_TRACE
+		if (smc_fid == PMF_SMC_TRACE_READ_64) {
+			pmf_trace_entry_t e[PMF_TRACE_READ_MAX] = { 0 };
+			unsigned long long seq;
+
+			/*
+			 * Return the number of trace entries read from the
+			 * buffer of the cpu `x1`, from the sequence number
+			 * `x2`, or an error code.
+			 * x0 --> number of entries or error code.
+			 * x1 --> sequence number of the first entry.
+			 * x2 - x7 --> entries, as pairs of
+			 *	       ((tid << 32) | arg, time-stamp).
+			 */
+			rc = pmf_trace_read(x1, x2, e, &seq);
+			if (rc < 0)
+				SMC_RET1(handle, rc);
+
+			SMC_RET8(handle, rc, seq,
+				((u_register_t)e[0].tid << 32) | e[0].arg,
+				e[0].ts,
+				((u_register_t)e[1].tid << 32) | e[1].arg,
+				e[1].ts,
+				((u_register_t)e[2].tid << 32) | e[2].arg,
+				e[2].ts);
+		}
+#endif
 	}
 
 	WARN("Unimplemented PMF Call: 0x%x \n", smc_fid);
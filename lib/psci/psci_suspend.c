@@ -12,6 +12,7 @@
 #include <common/bl_common.h>
 #include <common/debug.h>
 #include <context.h>
+#include <lib/el3_prof.h>
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/el3_runtime/cpu_data.h>
 #include <lib/el3_runtime/pubsub_events.h>
@@ -167,6 +168,15 @@ void psci_cpu_suspend_start(const entry_point_info_t *ep,
 	assert((psci_plat_pm_ops->pwr_domain_suspend != NULL) &&
 	       (psci_plat_pm_ops->pwr_domain_suspend_finish != NULL));
 
+#if ENABLE_EL3_PROF
+	/*
+	 * Stop sampling before the CPU may be powered down, as on CPU_OFF. A
+	 * standby state keeps the PMU state, and FIQs can stay unmasked.
+	 */
+	if (is_power_down_state != 0U)
+		el3_prof_stop();
+#endif
+
 	/* Get the parent nodes */
 	psci_get_parent_pwr_domain_nodes(idx, end_pwrlvl, parent_nodes);
 
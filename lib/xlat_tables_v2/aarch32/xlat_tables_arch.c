@@ -102,6 +102,30 @@ void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
 	}
 }
 
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime)
+{
+	size_t pages_count = size / PAGE_SIZE;
+
+	assert((size % PAGE_SIZE) == 0U);
+
+	if (pages_count <= XLAT_TLBI_VA_MAX_PAGES) {
+		for (size_t i = 0U; i < pages_count; i++) {
+			xlat_arch_tlbi_va(va, xlat_regime);
+			va += PAGE_SIZE;
+		}
+		return;
+	}
+
+	dsbishst();
+
+	if (xlat_regime == EL1_EL0_REGIME) {
+		tlbiallis();
+	} else {
+		assert(xlat_regime == EL2_REGIME);
+		tlbiallhis();
+	}
+}
+
 void xlat_arch_tlbi_va_sync(void)
 {
 	/* Invalidate all entries from branch predictors. */
@@ -185,6 +185,107 @@ void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
 	}
 }
 
+/*
+ * Invalidate all TLB entries of the given translation regime.
+ */
+static void xlat_arch_tlbi_all(int xlat_regime)
+{
+	if (xlat_regime == EL1_EL0_REGIME) {
+		assert(xlat_arch_current_el() >= 1U);
+		tlbivmalle1is();
+	} else if (xlat_regime == EL2_REGIME) {
+		assert(xlat_arch_current_el() >= 2U);
+		tlbialle2is();
+	} else {
+		assert(xlat_regime == EL3_REGIME);
+		assert(xlat_arch_current_el() >= 3U);
+		tlbialle3is();
+	}
+}
+
+/*
+ * Invalidate the TLB entries of a range of pages using a single ARMv8.4-TLBI
+ * range instruction. The range is described by the TLBI_RANGE() operand.
+ */
+static void xlat_arch_tlbi_range_op(uint64_t op, int xlat_regime)
+{
+	if (xlat_regime == EL1_EL0_REGIME) {
+		assert(xlat_arch_current_el() >= 1U);
+		tlbirvaae1is(op);
+	} else if (xlat_regime == EL2_REGIME) {
+		assert(xlat_arch_current_el() >= 2U);
+		tlbirvae2is(op);
+	} else {
+		assert(xlat_regime == EL3_REGIME);
+		assert(xlat_arch_current_el() >= 3U);
+		tlbirvae3is(op);
+	}
+}
+
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime)
+{
+	unsigned long long pages_count = size / PAGE_SIZE;
+	unsigned long long scale = 0ULL;
+
+	assert((size % PAGE_SIZE) == 0U);
+	assert(PAGE_SIZE == PAGE_SIZE_4KB);
+
+	if (!is_armv8_4_tlbi_range_present()) {
+		if (pages_count > XLAT_TLBI_VA_MAX_PAGES) {
+			dsbishst();
+			xlat_arch_tlbi_all(xlat_regime);
+			return;
+		}
+
+		for (unsigned long long i = 0ULL; i < pages_count; i++) {
+			xlat_arch_tlbi_va(va, xlat_regime);
+			va += PAGE_SIZE;
+		}
+		return;
+	}
+
+	/*
+	 * Ensure the translation table writes have drained into memory before
+	 * invalidating the TLB entries.
+	 */
+	dsbishst();
+
+	/* The loop below can't cover TLBI_RANGE_MAX_PAGES pages or more */
+	if (pages_count >= TLBI_RANGE_MAX_PAGES) {
+		xlat_arch_tlbi_all(xlat_regime);
+		return;
+	}
+
+	/*
+	 * A range instruction covers an even number of pages, a single page
+	 * invalidation is used when the remaining number of pages is odd. The
+	 * remaining pages are then covered with increasing values of SCALE, so
+	 * that at most one instruction is needed per value of SCALE.
+	 */
+	while (pages_count > 0ULL) {
+		if ((pages_count % 2ULL) != 0ULL) {
+			xlat_arch_tlbi_va(va, xlat_regime);
+			va += PAGE_SIZE;
+			pages_count--;
+			continue;
+		}
+
+		unsigned long long num = (pages_count >> ((5ULL * scale) + 1ULL)) &
+					 TLBI_RANGE_NUM_MASK;
+
+		if (num != 0ULL) {
+			num--;
+			xlat_arch_tlbi_range_op(TLBI_RANGE(va >> PAGE_SIZE_SHIFT,
+						num, scale, TLBI_RANGE_TG_4K),
+						xlat_regime);
+			va += TLBI_RANGE_PAGES(num, scale) * PAGE_SIZE;
+			pages_count -= TLBI_RANGE_PAGES(num, scale);
+		}
+
+		scale++;
+	}
+}
+
 void xlat_arch_tlbi_va_sync(void)
 {
 	/*
@@ -10,6 +10,7 @@
 #include <platform_def.h>
 
 #include <common/debug.h>
+#include <lib/spinlock.h>
 #include <lib/xlat_tables/xlat_tables_defs.h>
 #include <lib/xlat_tables/xlat_tables_v2.h>
 
@@ -21,12 +22,21 @@
  */
 uint64_t mmu_cfg_params[MMU_CFG_PARAM_MAX];
 
+#if defined(IMAGE_XLAT_TABLES_PREBUILT)
+/*
+ * The default translation context for the BL image currently executing is
+ * generated at build time from the static memory map of the image, with its
+ * translation tables already populated. See tools/xlat_tables_gen.
+ */
+extern xlat_ctx_t tf_xlat_ctx;
+#else
 /*
  * Allocate and initialise the default translation context for the BL image
  * currently executing.
  */
 REGISTER_XLAT_CONTEXT(tf, MAX_MMAP_REGIONS, MAX_XLAT_TABLES,
 		      PLAT_VIRT_ADDR_SPACE_SIZE, PLAT_PHY_ADDR_SPACE_SIZE);
+#endif
 
 void mmap_add_region(unsigned long long base_pa, uintptr_t base_va, size_t size,
 		     unsigned int attr)
@@ -62,12 +72,47 @@ void mmap_add_alloc_va(mmap_region_t *mm)
 
 #if PLAT_XLAT_TABLES_DYNAMIC
 
+#if defined(IMAGE_BL31) || defined(IMAGE_BL32)
+/*
+ * In runtime images, dynamic regions can be added and removed by services
+ * running concurrently on several cpus. Serialize the changes made to the
+ * default translation context. Before the MMU is enabled, only the primary
+ * cpu runs and the lock can't be relied upon, so it isn't taken.
+ */
+static spinlock_t tf_xlat_dynamic_lock;
+
+static void xlat_dynamic_lock(void)
+{
+	if (is_mmu_enabled_ctx(&tf_xlat_ctx))
+		spin_lock(&tf_xlat_dynamic_lock);
+}
+
+static void xlat_dynamic_unlock(void)
+{
+	if (is_mmu_enabled_ctx(&tf_xlat_ctx))
+		spin_unlock(&tf_xlat_dynamic_lock);
+}
+#else
+static inline void xlat_dynamic_lock(void)
+{
+}
+
+static inline void xlat_dynamic_unlock(void)
+{
+}
+#endif /* IMAGE_BL31 || IMAGE_BL32 */
+
 int mmap_add_dynamic_region(unsigned long long base_pa, uintptr_t base_va,
 			    size_t size, unsigned int attr)
 {
 	mmap_region_t mm = MAP_REGION(base_pa, base_va, size, attr);
+	int rc;
+
+	xlat_dynamic_lock();
+	rc = mmap_add_dynamic_region_ctx(&tf_xlat_ctx, &mm);
+	xlat_dynamic_unlock();
 
-	return mmap_add_dynamic_region_ctx(&tf_xlat_ctx, &mm);
+	return rc;
 }
 
 int mmap_add_dynamic_region_alloc_va(unsigned long long base_pa,
@@ -75,8 +120,11 @@ int mmap_add_dynamic_region_alloc_va(unsigned long long base_pa,
 				     unsigned int attr)
 {
 	mmap_region_t mm = MAP_REGION_ALLOC_VA(base_pa, size, attr);
+	int rc;
 
-	int rc = mmap_add_dynamic_region_alloc_va_ctx(&tf_xlat_ctx, &mm);
+	xlat_dynamic_lock();
+	rc = mmap_add_dynamic_region_alloc_va_ctx(&tf_xlat_ctx, &mm);
+	xlat_dynamic_unlock();
 
 	*base_va = mm.base_va;
 
@@ -86,12 +134,33 @@ int mmap_add_dynamic_region_alloc_va(unsigned long long base_pa,
 
 int mmap_remove_dynamic_region(uintptr_t base_va, size_t size)
 {
-	return mmap_remove_dynamic_region_ctx(&tf_xlat_ctx,
-					base_va, size);
+	int rc;
+
+	xlat_dynamic_lock();
+	rc = mmap_remove_dynamic_region_ctx(&tf_xlat_ctx, base_va, size);
+	xlat_dynamic_unlock();
+
+	return rc;
 }
 
 #endif /* PLAT_XLAT_TABLES_DYNAMIC */
 
+#if defined(IMAGE_XLAT_TABLES_PREBUILT)
+void __init init_xlat_tables(void)
+{
+	/*
+	 * The translation tables are ready to be used, only check that they
+	 * have been generated for the current exception level and that the
+	 * physical address space of the CPU is large enough.
+	 */
+	assert(tf_xlat_ctx.initialized);
+	assert(xlat_arch_current_el() ==
+	       ((tf_xlat_ctx.xlat_regime == EL3_REGIME) ? 3U : 1U));
+	assert(tf_xlat_ctx.pa_max_address <= xlat_arch_get_max_supported_pa());
+
+	xlat_tables_print(&tf_xlat_ctx);
+}
+#else
 void __init init_xlat_tables(void)
 {
 	assert(tf_xlat_ctx.xlat_regime == EL_REGIME_INVALID);
@@ -109,6 +178,7 @@ void __init init_xlat_tables(void)
 
 	init_xlat_tables_ctx(&tf_xlat_ctx);
 }
+#endif /* IMAGE_XLAT_TABLES_PREBUILT */
 
 int xlat_get_mem_attributes(uintptr_t base_va, uint32_t *attr)
 {
@@ -140,6 +210,11 @@ int xlat_change_mem_attributes(uintptr_t base_va, size_t size, uint32_t attr)
 int xlat_make_tables_readonly(void)
 {
 	assert(tf_xlat_ctx.initialized == true);
+
+	/* Prebuilt tables may already be in read-only memory */
+	if (tf_xlat_ctx.readonly_tables)
+		return 0;
+
 #ifdef __aarch64__
 	if (tf_xlat_ctx.xlat_regime == EL1_EL0_REGIME) {
 		disable_mmu_el1();
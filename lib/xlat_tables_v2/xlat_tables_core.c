@@ -42,45 +42,62 @@ static inline __attribute__((unused)) void xlat_clean_dcache_range(uintptr_t add
  */
 static int xlat_table_get_index(const xlat_ctx_t *ctx, const uint64_t *table)
 {
-	for (int i = 0; i < ctx->tables_num; i++)
-		if (ctx->tables[i] == table)
-			return i;
+	uintptr_t offset = (uintptr_t)table - (uintptr_t)ctx->tables;
 
 	/*
 	 * Maybe we were asked to get the index of the base level table, which
 	 * should never happen.
 	 */
-	assert(false);
+	assert((uintptr_t)table >= (uintptr_t)ctx->tables);
+	assert((offset % sizeof(ctx->tables[0])) == 0U);
+	assert((offset / sizeof(ctx->tables[0])) <
+	       (unsigned int)ctx->tables_num);
 
-	return -1;
+	return (int)(offset / sizeof(ctx->tables[0]));
 }
 
-/* Returns a pointer to an empty translation table. */
+/*
+ * Returns a pointer to an empty translation table. The table remains in the
+ * stack of free tables until a region is mapped in it.
+ */
 static uint64_t *xlat_table_get_empty(const xlat_ctx_t *ctx)
 {
-	for (int i = 0; i < ctx->tables_num; i++)
-		if (ctx->tables_mapped_regions[i] == 0)
-			return ctx->tables[i];
+	if (ctx->tables_free_num == 0)
+		return NULL;
 
-	return NULL;
+	return ctx->tables[ctx->tables_free[ctx->tables_free_num - 1]];
 }
 
 /* Increments region count for a given table. */
-static void xlat_table_inc_regions_count(const xlat_ctx_t *ctx,
+static void xlat_table_inc_regions_count(xlat_ctx_t *ctx,
 					 const uint64_t *table)
 {
 	int idx = xlat_table_get_index(ctx, table);
 
+	if (ctx->tables_mapped_regions[idx] == 0) {
+		/* Only the table returned by xlat_table_get_empty() is free */
+		assert(ctx->tables_free_num > 0);
+		assert(ctx->tables_free[ctx->tables_free_num - 1] == idx);
+		ctx->tables_free_num--;
+	}
+
 	ctx->tables_mapped_regions[idx]++;
 }
 
 /* Decrements region count for a given table. */
-static void xlat_table_dec_regions_count(const xlat_ctx_t *ctx,
+static void xlat_table_dec_regions_count(xlat_ctx_t *ctx,
 					 const uint64_t *table)
 {
 	int idx = xlat_table_get_index(ctx, table);
 
+	assert(ctx->tables_mapped_regions[idx] > 0);
 	ctx->tables_mapped_regions[idx]--;
+
+	if (ctx->tables_mapped_regions[idx] == 0) {
+		assert(ctx->tables_free_num < ctx->tables_num);
+		ctx->tables_free[ctx->tables_free_num] = idx;
+		ctx->tables_free_num++;
+	}
 }
 
 /* Returns 0 if the specified table isn't empty, otherwise 1. */
@@ -334,12 +351,18 @@ static action_t xlat_tables_unmap_region_action(const mmap_region_t *mm,
 		 * It can't happen in level 3.
 		 *
 		 * There must be a table descriptor here, if not there
-		 * was a problem when mapping the region.
+		 * was a problem when mapping the region. The only
+		 * exception is the entry that couldn't be mapped when
+		 * undoing a partial mapping, which is left invalid.
 		 */
 		assert(level < 3U);
-		assert(desc_type == TABLE_DESC);
 
-		action = ACTION_RECURSE_INTO_TABLE;
+		if (desc_type == TABLE_DESC) {
+			action = ACTION_RECURSE_INTO_TABLE;
+		} else {
+			assert(desc_type == INVALID_DESC);
+			action = ACTION_NONE;
+		}
 	} else {
 		/* The region doesn't cover the block at all */
 		action = ACTION_NONE;
@@ -349,7 +372,8 @@ static action_t xlat_tables_unmap_region_action(const mmap_region_t *mm,
 }
 /*
  * Recursive function that writes to the translation tables and unmaps the
- * specified region.
+ * specified region. The TLB entries of the region must be invalidated by the
+ * caller once the translation tables have been updated.
  */
 static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 				     const uintptr_t table_base_va,
@@ -386,7 +410,6 @@ static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 		if (action == ACTION_WRITE_BLOCK_ENTRY) {
 
 			table_base[table_idx] = INVALID_DESC;
-			xlat_arch_tlbi_va(table_idx_va, ctx->xlat_regime);
 
 		} else if (action == ACTION_RECURSE_INTO_TABLE) {
 
@@ -405,8 +428,6 @@ static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 			 */
 			if (xlat_table_is_empty(ctx, subtable)) {
 				table_base[table_idx] = INVALID_DESC;
-				xlat_arch_tlbi_va(table_idx_va,
-						  ctx->xlat_regime);
 			}
 
 		} else {
@@ -558,6 +579,41 @@ static action_t xlat_tables_map_region_action(const mmap_region_t *mm,
 	}
 }
 
+/*
+ * Returns true if the group of XLAT_CONTIG_ENTRIES descriptors starting at
+ * table_idx can be marked with the contiguous hint when mapping the specified
+ * region, i.e. if the first descriptor of the group is written as a block or
+ * page descriptor, the whole group is covered by the region, its output
+ * address is aligned to the size of the group, and all the descriptors of the
+ * group are invalid. All of them are then written with consecutive output
+ * addresses and the same attributes. Valid descriptors are never modified so
+ * that the contiguous hint doesn't need a break-before-make sequence.
+ */
+static bool xlat_tables_map_contig_allowed(const mmap_region_t *mm,
+		const uint64_t *table_base, unsigned int table_entries,
+		unsigned int table_idx, uintptr_t table_idx_va,
+		unsigned long long table_idx_pa, unsigned int level,
+		action_t action)
+{
+	uintptr_t mm_end_va = mm->base_va + mm->size - 1U;
+
+	if ((action != ACTION_WRITE_BLOCK_ENTRY) ||
+	    ((table_idx % XLAT_CONTIG_ENTRIES) != 0U) ||
+	    ((table_idx + XLAT_CONTIG_ENTRIES) > table_entries))
+		return false;
+
+	if (((table_idx_pa & (XLAT_CONTIG_SIZE(level) - 1U)) != 0U) ||
+	    ((mm_end_va - table_idx_va) < (XLAT_CONTIG_SIZE(level) - 1U)))
+		return false;
+
+	for (unsigned int i = 0U; i < XLAT_CONTIG_ENTRIES; i++) {
+		if ((table_base[table_idx + i] & DESC_MASK) != INVALID_DESC)
+			return false;
+	}
+
+	return true;
+}
+
 /*
  * Recursive function that writes to the translation tables and maps the
  * specified region. On success, it returns the VA of the last byte that was
@@ -582,6 +638,9 @@ static uintptr_t xlat_tables_map_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 
 	unsigned int table_idx;
 
+	/* Set when the current group of entries uses the contiguous hint */
+	bool contig = false;
+
 	table_idx_va = xlat_tables_find_start_va(mm, table_base_va, level);
 	table_idx = xlat_tables_va_to_index(table_base_va, table_idx_va, level);
 
@@ -600,11 +659,20 @@ static uintptr_t xlat_tables_map_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 			(uint32_t)(desc & DESC_MASK), table_idx_pa,
 			table_idx_va, level);
 
+		if ((table_idx % XLAT_CONTIG_ENTRIES) == 0U) {
+			contig = xlat_tables_map_contig_allowed(mm, table_base,
+					table_entries, table_idx, table_idx_va,
+					table_idx_pa, level, action);
+		}
+
 		if (action == ACTION_WRITE_BLOCK_ENTRY) {
 
-			table_base[table_idx] =
-				xlat_desc(ctx, (uint32_t)mm->attr, table_idx_pa,
-					  level);
+			desc = xlat_desc(ctx, (uint32_t)mm->attr, table_idx_pa,
+					 level);
+			if (contig)
+				desc |= UPPER_ATTRS(CONT_HINT);
+
+			table_base[table_idx] = desc;
 
 		} else if (action == ACTION_CREATE_NEW_TABLE) {
 			uintptr_t end_va;
@@ -768,9 +836,56 @@ static int mmap_add_region_check(const xlat_ctx_t *ctx, const mmap_region_t *mm)
 	return 0;
 }
 
+/*
+ * Returns true if the region pointed by mm is placed after a region ending at
+ * end_va with the given size in the mmap array. A size of 0 is used to look for
+ * the end of the array: empty regions are placed after any other region.
+ */
+static bool mmap_region_is_after(const mmap_region_t *mm, uintptr_t end_va,
+				 size_t size)
+{
+	uintptr_t mm_end_va;
+
+	if (mm->size == 0U)
+		return true;
+
+	if (size == 0U)
+		return false;
+
+	mm_end_va = mm->base_va + mm->size - 1U;
+
+	return (mm_end_va > end_va) ||
+	       ((mm_end_va == end_va) && (mm->size >= size));
+}
+
+/*
+ * Returns the first region of the mmap array that is placed after a region
+ * ending at end_va with the given size, i.e. the place where such a region is
+ * inserted. If size is 0, it returns the empty entry that terminates the array.
+ * The array is sorted, so a binary search is used.
+ */
+static mmap_region_t *mmap_find_position(const xlat_ctx_t *ctx,
+					 uintptr_t end_va, size_t size)
+{
+	unsigned int low = 0U;
+	unsigned int high = (unsigned int)ctx->mmap_num;
+
+	while (low < high) {
+		unsigned int mid = low + ((high - low) / 2U);
+
+		if (mmap_region_is_after(&ctx->mmap[mid], end_va, size)) {
+			high = mid;
+		} else {
+			low = mid + 1U;
+		}
+	}
+
+	return &ctx->mmap[low];
+}
+
 void mmap_add_region_ctx(xlat_ctx_t *ctx, const mmap_region_t *mm)
 {
-	mmap_region_t *mm_cursor = ctx->mmap, *mm_destination;
+	mmap_region_t *mm_cursor, *mm_destination;
 	const mmap_region_t *mm_end = ctx->mmap + ctx->mmap_num;
 	const mmap_region_t *mm_last;
 	unsigned long long end_pa = mm->base_pa + mm->size - 1U;
@@ -781,8 +896,17 @@ void mmap_add_region_ctx(xlat_ctx_t *ctx, const mmap_region_t *mm)
 	if (mm->size == 0U)
 		return;
 
-	/* Static regions must be added before initializing the xlat tables. */
-	assert(!ctx->initialized);
+	/*
+	 * Static regions must be added before initializing the xlat tables.
+	 * This is also the case of prebuilt tables, which are initialized at
+	 * build time. Adding one afterwards would only update the memory map,
+	 * not the tables, so this is a fatal error even without assertions.
+	 */
+	if (ctx->initialized) {
+		ERROR("Static region VA:0x%lx added to initialized translation tables\n",
+		      mm->base_va);
+		panic();
+	}
 
 	ret = mmap_add_region_check(ctx, mm);
 	if (ret != 0) {
@@ -814,24 +938,12 @@ void mmap_add_region_ctx(xlat_ctx_t *ctx, const mmap_region_t *mm)
 	 *
 	 * Overlapping is only allowed for static regions.
 	 */
-
-	while (((mm_cursor->base_va + mm_cursor->size - 1U) < end_va)
-	       && (mm_cursor->size != 0U)) {
-		++mm_cursor;
-	}
-
-	while (((mm_cursor->base_va + mm_cursor->size - 1U) == end_va) &&
-	       (mm_cursor->size != 0U) && (mm_cursor->size < mm->size)) {
-		++mm_cursor;
-	}
+	mm_cursor = mmap_find_position(ctx, end_va, mm->size);
 
 	/*
 	 * Find the last entry marker in the mmap
 	 */
-	mm_last = ctx->mmap;
-	while ((mm_last->size != 0U) && (mm_last < mm_end)) {
-		++mm_last;
-	}
+	mm_last = mmap_find_position(ctx, 0U, 0U);
 
 	/*
 	 * Check if we have enough space in the memory mapping table.
@@ -948,8 +1060,8 @@ void mmap_add_ctx(xlat_ctx_t *ctx, const mmap_region_t *mm)
 
 int mmap_add_dynamic_region_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 {
-	mmap_region_t *mm_cursor = ctx->mmap;
-	const mmap_region_t *mm_last = mm_cursor + ctx->mmap_num;
+	mmap_region_t *mm_cursor;
+	const mmap_region_t *mm_last;
 	unsigned long long end_pa = mm->base_pa + mm->size - 1U;
 	uintptr_t end_va = mm->base_va + mm->size - 1U;
 	int ret;
@@ -969,27 +1081,22 @@ int mmap_add_dynamic_region_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 	 * Find the adequate entry in the mmap array in the same way done for
 	 * static regions in mmap_add_region_ctx().
 	 */
+	mm_cursor = mmap_find_position(ctx, end_va, mm->size);
+	mm_last = mmap_find_position(ctx, 0U, 0U);
 
-	while (((mm_cursor->base_va + mm_cursor->size - 1U) < end_va)
-	       && (mm_cursor->size != 0U)) {
-		++mm_cursor;
-	}
-
-	while (((mm_cursor->base_va + mm_cursor->size - 1U) == end_va) &&
-	       (mm_cursor->size != 0U) && (mm_cursor->size < mm->size)) {
-		++mm_cursor;
-	}
-
-	/* Make room for new region by moving other regions up by one place */
+	/*
+	 * Make room for new region by moving other regions up by one place.
+	 * This shouldn't overflow as we have checked in mmap_add_region_check
+	 * that there is free space.
+	 */
+	assert(mm_last < (ctx->mmap + ctx->mmap_num));
 	(void)memmove(mm_cursor + 1U, mm_cursor,
 		     (uintptr_t)mm_last - (uintptr_t)mm_cursor);
 
 	/*
 	 * Check we haven't lost the empty sentinal from the end of the array.
-	 * This shouldn't happen as we have checked in mmap_add_region_check
-	 * that there is free space.
 	 */
-	assert(mm_last->size == 0U);
+	assert(ctx->mmap[ctx->mmap_num].size == 0U);
 
 	*mm_cursor = *mm;
 
@@ -1007,24 +1114,26 @@ int mmap_add_dynamic_region_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 #endif
 		/* Failed to map, remove mmap entry, unmap and return error. */
 		if (end_va != (mm_cursor->base_va + mm_cursor->size - 1U)) {
-			(void)memmove(mm_cursor, mm_cursor + 1U,
-				(uintptr_t)mm_last - (uintptr_t)mm_cursor);
-
 			/*
-			 * Check if the mapping function actually managed to map
-			 * anything. If not, just return now.
+			 * The empty entry that terminates the array is now
+			 * after mm_last, move it down as well.
 			 */
-			if (mm->base_va >= end_va)
-				return -ENOMEM;
+			(void)memmove(mm_cursor, mm_cursor + 1U,
+				(uintptr_t)(mm_last + 1U) - (uintptr_t)mm_cursor);
 
 			/*
 			 * Something went wrong after mapping some table
 			 * entries, undo every change done up to this point.
+			 * The tables visited to map the entry at end_va that
+			 * couldn't be mapped have been accounted for this
+			 * region, and may have been allocated for it, even if
+			 * nothing else was mapped. Unmap this entry too so that
+			 * they are released.
 			 */
 			mmap_region_t unmap_mm = {
 					.base_pa = 0U,
 					.base_va = mm->base_va,
-					.size = end_va - mm->base_va,
+					.size = end_va - mm->base_va + 1U,
 					.attr = 0U
 			};
 			xlat_tables_unmap_region(ctx, &unmap_mm, 0U,
@@ -1034,6 +1143,11 @@ int mmap_add_dynamic_region_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 			xlat_clean_dcache_range((uintptr_t)ctx->base_table,
 				ctx->base_table_entries * sizeof(uint64_t));
 #endif
+			/* The range to invalidate must be a number of pages */
+			xlat_arch_tlbi_va_range(unmap_mm.base_va,
+				round_up(unmap_mm.size, PAGE_SIZE),
+				ctx->xlat_regime);
+			xlat_arch_tlbi_va_sync();
 			return -ENOMEM;
 		}
 
@@ -1083,22 +1197,26 @@ int mmap_add_dynamic_region_alloc_va_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 int mmap_remove_dynamic_region_ctx(xlat_ctx_t *ctx, uintptr_t base_va,
 				   size_t size)
 {
-	mmap_region_t *mm = ctx->mmap;
-	const mmap_region_t *mm_last = mm + ctx->mmap_num;
+	mmap_region_t *mm;
+	const mmap_region_t *mm_last;
 	int update_max_va_needed = 0;
 	int update_max_pa_needed = 0;
 
 	/* Check sanity of mmap array. */
-	assert(mm[ctx->mmap_num].size == 0U);
+	assert(ctx->mmap[ctx->mmap_num].size == 0U);
 
-	while (mm->size != 0U) {
-		if ((mm->base_va == base_va) && (mm->size == size))
-			break;
-		++mm;
-	}
+	if (size == 0U)
+		return -EINVAL;
+
+	/*
+	 * Regions are sorted by end VA and size, and two regions can't cover
+	 * the exact same area, so the region can only be at this position.
+	 */
+	mm = mmap_find_position(ctx, base_va + size - 1U, size);
+	mm_last = mmap_find_position(ctx, 0U, 0U);
 
 	/* Check that the region was found */
-	if (mm->size == 0U)
+	if ((mm->size == 0U) || (mm->base_va != base_va) || (mm->size != size))
 		return -EINVAL;
 
 	/* If the region is static it can't be removed */
@@ -1120,21 +1238,26 @@ int mmap_remove_dynamic_region_ctx(xlat_ctx_t *ctx, uintptr_t base_va,
 		xlat_clean_dcache_range((uintptr_t)ctx->base_table,
 			ctx->base_table_entries * sizeof(uint64_t));
 #endif
+		xlat_arch_tlbi_va_range(mm->base_va, mm->size,
+					ctx->xlat_regime);
 		xlat_arch_tlbi_va_sync();
 	}
 
-	/* Remove this region by moving the rest down by one place. */
+	/*
+	 * Remove this region by moving the rest down by one place, including
+	 * the empty entry that terminates the array.
+	 */
 	(void)memmove(mm, mm + 1U, (uintptr_t)mm_last - (uintptr_t)mm);
 
-	/* Check if we need to update the max VAs and PAs */
+	/*
+	 * Check if we need to update the max VAs and PAs. The region with the
+	 * highest end VA is the last one of the array.
+	 */
 	if (update_max_va_needed == 1) {
 		ctx->max_va = 0U;
-		mm = ctx->mmap;
-		while (mm->size != 0U) {
-			if ((mm->base_va + mm->size - 1U) > ctx->max_va)
-				ctx->max_va = mm->base_va + mm->size - 1U;
-			++mm;
-		}
+		mm = mmap_find_position(ctx, 0U, 0U);
+		if (mm != ctx->mmap)
+			ctx->max_va = (mm - 1)->base_va + (mm - 1)->size - 1U;
 	}
 
 	if (update_max_pa_needed == 1) {
@@ -1154,7 +1277,8 @@ void xlat_setup_dynamic_ctx(xlat_ctx_t *ctx, unsigned long long pa_max,
 			    uintptr_t va_max, struct mmap_region *mmap,
 			    unsigned int mmap_num, uint64_t **tables,
 			    unsigned int tables_num, uint64_t *base_table,
-			    int xlat_regime, int *mapped_regions)
+			    int xlat_regime, int *mapped_regions,
+			    int *free_tables)
 {
 	ctx->xlat_regime = xlat_regime;
 
@@ -1174,6 +1298,8 @@ void xlat_setup_dynamic_ctx(xlat_ctx_t *ctx, unsigned long long pa_max,
 	ctx->base_table_entries = GET_NUM_BASE_LEVEL_ENTRIES(va_space_size);
 
 	ctx->tables_mapped_regions = mapped_regions;
+	ctx->tables_free = free_tables;
+	ctx->tables_free_num = 0;
 
 	ctx->max_pa = 0;
 	ctx->max_va = 0;
@@ -1208,11 +1334,18 @@ void __init init_xlat_tables_ctx(xlat_ctx_t *ctx)
 	for (int j = 0; j < ctx->tables_num; j++) {
 #if PLAT_XLAT_TABLES_DYNAMIC
 		ctx->tables_mapped_regions[j] = 0;
+
+		/* The tables with the lowest indices are used first. */
+		ctx->tables_free[j] = ctx->tables_num - 1 - j;
 #endif
 		for (unsigned int i = 0U; i < XLAT_TABLE_ENTRIES; i++)
 			ctx->tables[j][i] = INVALID_DESC;
 	}
 
+#if PLAT_XLAT_TABLES_DYNAMIC
+	ctx->tables_free_num = ctx->tables_num;
+#endif
+
 	while (mm->size != 0U) {
 		uintptr_t end_va = xlat_tables_map_region(ctx, mm, 0U,
 				ctx->base_table, ctx->base_table_entries,
@@ -59,9 +59,33 @@ uint64_t xlat_arch_regime_get_xn_desc(int xlat_regime);
  */
 void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime);
 
+/*
+ * Number of adjacent and naturally aligned block or page descriptors that are
+ * marked with the contiguous hint when they map consecutive output addresses
+ * with the same attributes. This is the number for a 4KB translation granule.
+ */
+#define XLAT_CONTIG_ENTRIES	U(16)
+#define XLAT_CONTIG_SIZE(level)	(XLAT_CONTIG_ENTRIES * XLAT_BLOCK_SIZE(level))
+
+/*
+ * Maximum number of pages that xlat_arch_tlbi_va_range() invalidates one by
+ * one. Above this number, all the TLB entries of the translation regime are
+ * invalidated instead.
+ */
+#define XLAT_TLBI_VA_MAX_PAGES	U(512)
+
+/*
+ * Invalidate all TLB entries that match the virtual addresses of the given
+ * range. This has the same effect as calling xlat_arch_tlbi_va() for every
+ * page of the range, but uses the TLB range invalidation instructions when
+ * they are available and invalidates all the TLB entries of the translation
+ * regime when the range is too big.
+ */
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime);
+
 /*
  * This function has to be called at the end of any code that uses the function
- * xlat_arch_tlbi_va().
+ * xlat_arch_tlbi_va() or xlat_arch_tlbi_va_range().
  */
 void xlat_arch_tlbi_va_sync(void);
 
@@ -103,6 +103,10 @@ static void xlat_desc_print(const xlat_ctx_t *ctx, uint64_t desc)
 		printf("-GP");
 	}
 #endif
+
+	if ((desc & UPPER_ATTRS(CONT_HINT)) != 0ULL) {
+		printf("-CONT");
+	}
 }
 
 static const char * const level_spacers[] = {
@@ -117,11 +121,15 @@ static const char *invalid_descriptors_ommited =
 
 /*
  * Recursive function that reads the translation tables passed as an argument
- * and prints their status.
+ * and prints their status. It also accumulates in desc_count the number of
+ * block and page descriptors found and in tlb_count the number of TLB entries
+ * needed to cache them, a group of descriptors using the contiguous hint only
+ * needing one.
  */
 static void xlat_tables_print_internal(xlat_ctx_t *ctx, uintptr_t table_base_va,
 		const uint64_t *table_base, unsigned int table_entries,
-		unsigned int level)
+		unsigned int level, unsigned int *desc_count,
+		unsigned int *tlb_count)
 {
 	assert(level <= XLAT_TABLE_LEVEL_MAX);
 
@@ -181,14 +189,22 @@ static void xlat_tables_print_internal(xlat_ctx_t *ctx, uintptr_t table_base_va,
 
 				xlat_tables_print_internal(ctx, table_idx_va,
 					(uint64_t *)addr_inner,
-					XLAT_TABLE_ENTRIES, level + 1U);
+					XLAT_TABLE_ENTRIES, level + 1U,
+					desc_count, tlb_count);
 			} else {
 				printf("%sVA:0x%lx PA:0x%llx size:0x%zx ",
 				       level_spacers[level], table_idx_va,
-				       (uint64_t)(desc & TABLE_ADDR_MASK),
+				       (unsigned long long)
+				       (desc & TABLE_ADDR_MASK),
 				       level_size);
 				xlat_desc_print(ctx, desc);
 				printf("\n");
+
+				(*desc_count)++;
+				if (((desc & UPPER_ATTRS(CONT_HINT)) == 0ULL) ||
+				    ((table_idx % XLAT_CONTIG_ENTRIES) == 0U)) {
+					(*tlb_count)++;
+				}
 			}
 		}
 
@@ -206,6 +222,7 @@ void xlat_tables_print(xlat_ctx_t *ctx)
 {
 	const char *xlat_regime_str;
 	int used_page_tables;
+	unsigned int desc_count = 0U, tlb_count = 0U;
 
 	if (ctx->xlat_regime == EL1_EL0_REGIME) {
 		xlat_regime_str = "1&0";
@@ -240,7 +257,11 @@ void xlat_tables_print(xlat_ctx_t *ctx)
 		ctx->tables_num - used_page_tables);
 
 	xlat_tables_print_internal(ctx, 0U, ctx->base_table,
-				   ctx->base_table_entries, ctx->base_level);
+				   ctx->base_table_entries, ctx->base_level,
+				   &desc_count, &tlb_count);
+
+	VERBOSE("  Block/page descriptors: %u (TLB entries needed: %u)\n",
+		desc_count, tlb_count);
 }
 
 #endif /* LOG_LEVEL >= LOG_LEVEL_VERBOSE */
@@ -325,6 +346,31 @@ static uint64_t *find_xlat_table_entry(uintptr_t virtual_addr,
 }
 
 
+/*
+ * Returns true if the XLAT_CONTIG_ENTRIES page descriptors pointed by entries
+ * have the same attributes and map consecutive output addresses aligned to the
+ * size of the group, so that they can be marked with the contiguous hint.
+ */
+static bool xlat_pages_contig_allowed(const uint64_t *entries)
+{
+	uint64_t attr_mask = ~(TABLE_ADDR_MASK | UPPER_ATTRS(CONT_HINT));
+	unsigned long long addr_pa = entries[0] & TABLE_ADDR_MASK;
+
+	if ((addr_pa & (XLAT_CONTIG_SIZE(XLAT_TABLE_LEVEL_MAX) - 1U)) != 0U)
+		return false;
+
+	for (unsigned int i = 1U; i < XLAT_CONTIG_ENTRIES; ++i) {
+		if ((entries[i] & attr_mask) != (entries[0] & attr_mask))
+			return false;
+
+		if ((entries[i] & TABLE_ADDR_MASK) !=
+		    (addr_pa + ((unsigned long long)i * PAGE_SIZE)))
+			return false;
+	}
+
+	return true;
+}
+
 static int xlat_get_mem_attributes_internal(const xlat_ctx_t *ctx,
 		uintptr_t base_va, uint32_t *attributes, uint64_t **table_entry,
 		unsigned long long *addr_pa, unsigned int *table_level)
@@ -462,6 +508,11 @@ int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 		return -EINVAL;
 	}
 
+	if (ctx->readonly_tables) {
+		WARN("%s: Translation tables are read-only.\n", __func__);
+		return -EPERM;
+	}
+
 	size_t pages_count = size / PAGE_SIZE;
 
 	VERBOSE("Changing memory attributes of %zu pages starting from address 0x%lx...\n",
@@ -520,52 +571,137 @@ int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 	/* Restore original value. */
 	base_va = base_va_original;
 
-	for (unsigned int i = 0U; i < pages_count; ++i) {
-
-		uint32_t old_attr = 0U, new_attr;
-		uint64_t *entry = NULL;
-		unsigned int level = 0U;
-		unsigned long long addr_pa = 0ULL;
-
-		(void) xlat_get_mem_attributes_internal(ctx, base_va, &old_attr,
-					    &entry, &addr_pa, &level);
+	while (pages_count > 0U) {
+		uint64_t *table;
+		uintptr_t first_va;
+		unsigned int table_level;
 
 		/*
-		 * From attr, only MT_RO/MT_RW, MT_EXECUTE/MT_EXECUTE_NEVER and
-		 * MT_USER/MT_PRIVILEGED are taken into account. Any other
-		 * information is ignored.
+		 * All the pages are mapped at page granularity, so their
+		 * descriptors are contiguous in memory within a translation
+		 * table. They are updated one aligned group of
+		 * XLAT_CONTIG_ENTRIES descriptors at a time, which is the
+		 * smallest chunk that can be changed when the contiguous hint
+		 * is used. This bounds the number of pages that are invalid at
+		 * the same time during the break-before-make sequence below, so
+		 * that concurrent accesses to pages outside of the chunk, or to
+		 * the pages of the following chunks, don't fault.
 		 */
+		unsigned int start_idx = (unsigned int)
+			((base_va >> PAGE_SIZE_SHIFT) & (XLAT_TABLE_ENTRIES - 1U));
+		unsigned int end_idx = round_up(start_idx + 1U,
+						XLAT_CONTIG_ENTRIES);
 
-		/* Clean the old attributes so that they can be rebuilt. */
-		new_attr = old_attr & ~(MT_RW | MT_EXECUTE_NEVER | MT_USER);
+		if ((end_idx - start_idx) > pages_count)
+			end_idx = start_idx + (unsigned int)pages_count;
+
+		table = find_xlat_table_entry(base_va, ctx->base_table,
+					      ctx->base_table_entries,
+					      virt_addr_space_size,
+					      &table_level);
+		assert((table != NULL) && (table_level == XLAT_TABLE_LEVEL_MAX));
+		table -= start_idx;
 
 		/*
-		 * Update attributes, but filter out the ones this function
-		 * isn't allowed to change.
+		 * The contiguous hint of a group of descriptors can only be
+		 * changed with a break-before-make sequence of the whole group.
+		 * Extend the chunk to the groups that are only partially
+		 * covered by the pages to update.
 		 */
-		new_attr |= attr & (MT_RW | MT_EXECUTE_NEVER | MT_USER);
+		unsigned int first_idx = start_idx;
+		unsigned int last_idx = end_idx;
+
+		if ((table[start_idx] & UPPER_ATTRS(CONT_HINT)) != 0U)
+			first_idx = round_down(start_idx, XLAT_CONTIG_ENTRIES);
+		if ((table[end_idx - 1U] & UPPER_ATTRS(CONT_HINT)) != 0U)
+			last_idx = round_up(end_idx, XLAT_CONTIG_ENTRIES);
+
+		first_va = base_va - ((start_idx - first_idx) * PAGE_SIZE);
 
 		/*
 		 * The break-before-make sequence requires writing an invalid
 		 * descriptor and making sure that the system sees the change
-		 * before writing the new descriptor.
+		 * before writing the new descriptor. The new descriptors are
+		 * written with their type cleared, which makes them invalid, so
+		 * that they only need to be made valid once the whole chunk has
+		 * been invalidated.
+		 */
+		for (unsigned int i = first_idx; i < start_idx; ++i)
+			table[i] &= ~(UPPER_ATTRS(CONT_HINT) | DESC_MASK);
+		for (unsigned int i = end_idx; i < last_idx; ++i)
+			table[i] &= ~(UPPER_ATTRS(CONT_HINT) | DESC_MASK);
+
+		for (unsigned int i = start_idx; i < end_idx; ++i) {
+
+			uint32_t old_attr = 0U, new_attr;
+			uint64_t *entry = NULL;
+			unsigned int level = 0U;
+			unsigned long long addr_pa = 0ULL;
+
+			(void) xlat_get_mem_attributes_internal(ctx,
+					base_va + ((i - start_idx) * PAGE_SIZE),
+					&old_attr, &entry, &addr_pa, &level);
+
+			assert(entry == &table[i]);
+
+			/*
+			 * From attr, only MT_RO/MT_RW, MT_EXECUTE/MT_EXECUTE_NEVER
+			 * and MT_USER/MT_PRIVILEGED are taken into account. Any
+			 * other information is ignored.
+			 */
+
+			/*
+			 * Clean the old attributes so that they can be rebuilt.
+			 */
+			new_attr = old_attr &
+				   ~(MT_RW | MT_EXECUTE_NEVER | MT_USER);
+
+			/*
+			 * Update attributes, but filter out the ones this
+			 * function isn't allowed to change.
+			 */
+			new_attr |= attr & (MT_RW | MT_EXECUTE_NEVER | MT_USER);
+
+			*entry = xlat_desc(ctx, new_attr, addr_pa, level) &
+				   ~(uint64_t)DESC_MASK;
+		}
+
+		/*
+		 * Use the contiguous hint for the groups of the chunk that map
+		 * consecutive output addresses with the same attributes.
 		 */
-		*entry = INVALID_DESC;
+		for (unsigned int i = round_up(first_idx, XLAT_CONTIG_ENTRIES);
+		     (i + XLAT_CONTIG_ENTRIES) <= last_idx;
+		     i += XLAT_CONTIG_ENTRIES) {
+			if (!xlat_pages_contig_allowed(&table[i]))
+				continue;
+
+			for (unsigned int j = i; j < (i + XLAT_CONTIG_ENTRIES);
+			     ++j)
+				table[j] |= UPPER_ATTRS(CONT_HINT);
+		}
+
 #if !HW_ASSISTED_COHERENCY
-		dccvac((uintptr_t)entry);
+		clean_dcache_range((uintptr_t)&table[first_idx],
+				   (last_idx - first_idx) * sizeof(uint64_t));
 #endif
-		/* Invalidate any cached copy of this mapping in the TLBs. */
-		xlat_arch_tlbi_va(base_va, ctx->xlat_regime);
+		/* Invalidate any cached copy of these mappings in the TLBs. */
+		xlat_arch_tlbi_va_range(first_va,
+					(last_idx - first_idx) * PAGE_SIZE,
+					ctx->xlat_regime);
 
 		/* Ensure completion of the invalidation. */
 		xlat_arch_tlbi_va_sync();
 
-		/* Write new descriptor */
-		*entry = xlat_desc(ctx, new_attr, addr_pa, level);
+		/* Write new descriptors */
+		for (unsigned int i = first_idx; i < last_idx; ++i)
+			table[i] |= PAGE_DESC;
 #if !HW_ASSISTED_COHERENCY
-		dccvac((uintptr_t)entry);
+		clean_dcache_range((uintptr_t)&table[first_idx],
+				   (last_idx - first_idx) * sizeof(uint64_t));
 #endif
-		base_va += PAGE_SIZE;
+		base_va += (end_idx - start_idx) * PAGE_SIZE;
+		pages_count -= end_idx - start_idx;
 	}
 
 	/* Ensure that the last descriptor writen is seen by the system. */
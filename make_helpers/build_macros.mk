@@ -436,6 +436,43 @@ ${LIB_DIR}/lib$(1).a: $(OBJS)
 	$$(Q)$$(AR) cr $$@ $$?
 endef
 
+# MAKE_XLAT_TABLES builds the host tool that generates the translation tables of
+# a BL image from its static memory map, and compiles the generated tables. The
+# Makefile of the tool is run at each build, as it tracks the dependencies of
+# the tool on its sources and headers, but it only relinks the tool when one of
+# them has changed. The generated source depends on the tool binary, so it is
+# only generated again when the tool has been rebuilt, and only updated when
+# its content changes.
+#   $(1) = output directory
+#   $(2) = sources of the static memory map of the BL image
+#   $(3) = BL stage (1, 2, 2u, 31, 32)
+#   $(4) = name of the memory map table defined in the sources
+define MAKE_XLAT_TABLES
+
+$(eval GEN_DIR  := $(1)/xlat_tables_gen)
+$(eval GEN_TOOL := $(GEN_DIR)/xlat_tables_gen$(BIN_EXT))
+$(eval GEN_SRC  := $(1)/xlat_tables_prebuilt.c)
+$(eval BL_CPPFLAGS := $(BL$(call uppercase,$(3))_CPPFLAGS) -DIMAGE_BL$(call uppercase,$(3)) -DXLAT_GEN_MMAP=$(4))
+
+$(eval $(call MAKE_PREREQ_DIR,$(GEN_DIR),$(1)))
+
+.PHONY: xlat_tables_gen_bl$(3)
+xlat_tables_gen_bl$(3):
+
+$(GEN_TOOL): xlat_tables_gen_bl$(3) | $(GEN_DIR)
+	$$(Q)$$(MAKE) --no-print-directory -C $(XLAT_TABLES_GEN_PATH) \
+		BUILD_DIR=$(abspath $(GEN_DIR)) MMAP_SOURCES='$(2)' \
+		INCLUDES='$$(INCLUDES)' DEFINES='$$(DEFINES) $(BL_CPPFLAGS)'
+
+$(GEN_SRC): $(GEN_TOOL)
+	$$(Q)$(GEN_TOOL) $$@.tmp
+	$$(Q)if cmp -s $$@.tmp $$@; then rm $$@.tmp; else \
+		echo "  XLATGEN $$@"; mv $$@.tmp $$@; fi
+
+$(eval $(call MAKE_C,$(1),$(GEN_SRC),$(3)))
+
+endef
+
 # MAKE_BL macro defines the targets and options to build each BL image.
 # Arguments:
 #   $(1) = BL stage (1, 2, 2u, 31, 32)
@@ -447,6 +484,11 @@ define MAKE_BL
         $(eval BL_SOURCES := $(BL$(call uppercase,$(1))_SOURCES))
         $(eval SOURCES    := $(BL_SOURCES) $(BL_COMMON_SOURCES) $(PLAT_BL_COMMON_SOURCES))
         $(eval OBJS       := $(addprefix $(BUILD_DIR)/,$(call SOURCES_TO_OBJS,$(SOURCES))))
+        $(eval XLAT_MMAP_SOURCES := $(if $(filter 1,$(XLAT_TABLES_PREBUILT)),$(BL$(call uppercase,$(1))_XLAT_MMAP_SOURCES)))
+        $(eval XLAT_MMAP  := $(BL$(call uppercase,$(1))_XLAT_MMAP))
+        $(if $(XLAT_MMAP_SOURCES),$(if $(XLAT_MMAP),,$(error "BL$(call uppercase,$(1))_XLAT_MMAP must name the memory map defined in BL$(call uppercase,$(1))_XLAT_MMAP_SOURCES")))
+        $(if $(XLAT_MMAP_SOURCES),$(eval BL$(call uppercase,$(1))_CPPFLAGS += -DIMAGE_XLAT_TABLES_PREBUILT))
+        $(if $(XLAT_MMAP_SOURCES),$(eval OBJS += $(BUILD_DIR)/xlat_tables_prebuilt.o))
         $(eval LINKERFILE := $(call IMG_LINKERFILE,$(1)))
         $(eval MAPFILE    := $(call IMG_MAPFILE,$(1)))
         $(eval ELF        := $(call IMG_ELF,$(1)))
@@ -475,6 +517,7 @@ $(eval $(foreach objd,${OBJ_DIRS},$(call MAKE_PREREQ_DIR,${objd},${BUILD_DIR})))
 bl${1}_dirs: | ${OBJ_DIRS}
 
 $(eval $(call MAKE_OBJS,$(BUILD_DIR),$(SOURCES),$(1)))
+$(if $(XLAT_MMAP_SOURCES),$(eval $(call MAKE_XLAT_TABLES,$(BUILD_DIR),$(XLAT_MMAP_SOURCES),$(1),$(XLAT_MMAP))))
 $(eval $(call MAKE_LD,$(LINKERFILE),$(BL_LINKERFILE),$(1)))
 $(eval BL_LDFLAGS := $(BL$(call uppercase,$(1))_LDFLAGS))
 
@@ -43,6 +43,9 @@ BRANCH_PROTECTION		:= 0
 # The platform Makefile is free to override this value.
 COLD_BOOT_SINGLE_CPU		:= 0
 
+# Size of the software buffer of the console output. 0 means unbuffered output.
+CONSOLE_TX_BUF_SIZE		:= 0
+
 # Flag to compile in coreboot support code. Exclude by default. The coreboot
 # Makefile system will set this when compiling TF as part of a coreboot image.
 COREBOOT			:= 0
@@ -62,6 +65,14 @@ CTX_INCLUDE_FPREGS		:= 0
 # world. It is not needed to use it in the Non-secure world.
 CTX_INCLUDE_PAUTH_REGS		:= 0
 
+# Group the cpu context registers accessed on every exception entry and exit
+# in the first cache lines of the context
+CTX_HOT_REGS_FIRST		:= 0
+
+# Only save and restore the optional groups of EL1 system registers for the
+# security states that are able to access them
+CTX_LAZY_SYSREGS		:= 0
+
 # Debug build
 DEBUG				:= 0
 
@@ -81,6 +92,21 @@ DYN_DISABLE_AUTH		:= 0
 # Build option to enable MPAM for lower ELs
 ENABLE_MPAM_FOR_LOWER_ELS	:= 0
 
+# Flag to enable the recording of cold boot phase timestamps
+ENABLE_BOOT_INSTRUMENTATION	:= 0
+
+# Flag to enable EL3 exception handling statistics
+ENABLE_EHF_STAT			:= 0
+
+# Flag to enable the sampling profiler of the time spent in EL3
+ENABLE_EL3_PROF			:= 0
+
+# Flag to enable the per-CPU SMC call statistics
+ENABLE_SMC_STAT			:= 0
+
+# Flag to record log messages in a binary ring instead of printing them
+ENABLE_LOG_RING			:= 0
+
 # Flag to Enable Position Independant support (PIE)
 ENABLE_PIE			:= 0
 
@@ -93,6 +119,10 @@ ENABLE_PSCI_STAT		:= 0
 # Flag to enable runtime instrumentation using PMF
 ENABLE_RUNTIME_INSTRUMENTATION	:= 0
 
+# Flag to record the entry and exit timestamps of every SMC with the runtime
+# instrumentation
+ENABLE_SMC_INSTRUMENTATION	:= 0
+
 # Flag to enable stack corruption protection
 ENABLE_STACK_PROTECTOR		:= 0
 
@@ -174,6 +204,9 @@ OVERRIDE_LIBC			:= 0
 # Build PL011 UART driver in minimal generic UART mode
 PL011_GENERIC_UART		:= 0
 
+# Flag to record PMF timestamps in per-cpu trace buffers
+PMF_TRACE			:= 0
+
 # By default, consider that the platform's reset address is not programmable.
 # The platform Makefile is free to override this value.
 PROGRAMMABLE_RESET_ADDRESS	:= 0
@@ -214,6 +247,13 @@ SPM_MM				:= 0
 # Use SPM at S-EL2 as a default config for SPMD
 SPMD_SPM_AT_SEL2		:= 1
 
+# Only switch the S-EL2 context of the SPMC when forwarding FF-A direct
+# messages and FFA_MSG_RUN
+SPMD_FAST_FORWARD		:= 0
+
+# Dispatch a set of hot SMC function ids directly to their handlers
+SMC_FID_FAST_PATH		:= 0
+
 # Flag to introduce an infinite loop in BL1 just before it exits into the next
 # image. This is meant to help debugging the post-BL2 phase.
 SPIN_ON_BL1_EXIT		:= 0
@@ -246,6 +286,12 @@ USE_ROMLIB			:= 0
 # level makefile where we can check for incompatible features/build options.
 ALLOW_RO_XLAT_TABLES		:= 0
 
+# Build option to generate at build time the translation tables of the BL
+# images for which the platform provides a static memory map in
+# BL<x>_XLAT_MMAP and BL<x>_XLAT_MMAP_SOURCES, instead of building them at
+# runtime.
+XLAT_TABLES_PREBUILT		:= 0
+
 # Chain of trust.
 COT				:= tbbr
 
@@ -266,6 +266,12 @@ void arm_bl31_platform_setup(void)
 #if USE_DEBUGFS
 	debugfs_init();
 #endif /* USE_DEBUGFS */
+
+	/*
+	 * The weak definition of plat_validate_ns_buffer() rejects all buffers,
+	 * so check that the one of ARM standard platforms is linked instead.
+	 */
+	assert(plat_validate_ns_buffer(ARM_NS_DRAM1_BASE, PAGE_SIZE) == 0);
 }
 
 /*******************************************************************************
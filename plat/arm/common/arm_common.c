@@ -171,6 +171,35 @@ const mmap_region_t *plat_arm_get_mmap(void)
 	return plat_arm_mmap;
 }
 
+#ifdef ARM_NS_DRAM1_BASE
+/*******************************************************************************
+ * ARM standard platform handler called to check that a buffer passed by the Non-
+ * secure world lies entirely within the Non-secure DRAM. Returns 0 if it does,
+ * or -1 otherwise. This overrides the weak definition in plat/common, which
+ * rejects all buffers, so it must not be weak itself.
+ ******************************************************************************/
+int plat_validate_ns_buffer(unsigned long long base, size_t size)
+{
+	unsigned long long end = base + size;
+
+	if ((size == 0U) || (end < base))
+		return -1;
+
+	if ((base >= ARM_NS_DRAM1_BASE) &&
+	    (end <= (ARM_NS_DRAM1_BASE + ARM_NS_DRAM1_SIZE))) {
+		return 0;
+	}
+#ifdef __aarch64__
+	if ((base >= ARM_DRAM2_BASE) &&
+	    (end <= (ARM_DRAM2_BASE + ARM_DRAM2_SIZE))) {
+		return 0;
+	}
+#endif
+
+	return -1;
+}
+#endif /* ARM_NS_DRAM1_BASE */
+
 #ifdef ARM_SYS_CNTCTL_BASE
 
 unsigned int plat_get_syscnt_freq2(void)
@@ -6,9 +6,11 @@
 
 #include <stdint.h>
 
+#include <bl31/ehf.h>
 #include <common/debug.h>
 #include <common/runtime_svc.h>
 #include <lib/debugfs.h>
+#include <lib/el3_prof.h>
 #include <lib/pmf/pmf.h>
 #include <plat/arm/common/arm_sip_svc.h>
 #include <plat/arm/common/plat_arm.h>
@@ -68,6 +70,33 @@ static uintptr_t arm_sip_handler(unsigned int smc_fid,
 
 #endif /* USE_DEBUGFS */
 
+#if ENABLE_EHF_STAT
+
+	if (is_ehf_fid(smc_fid)) {
+		return ehf_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
+				       handle, flags);
+	}
+
+#endif /* ENABLE_EHF_STAT */
+
+#if ENABLE_EL3_PROF
+
+	if (is_el3_prof_fid(smc_fid)) {
+		return el3_prof_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
+					    handle, flags);
+	}
+
+#endif /* ENABLE_EL3_PROF */
+
+#if ENABLE_SMC_STAT
+
+	if (is_smc_stat_fid(smc_fid)) {
+		return smc_stat_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
+					    handle, flags);
+	}
+
+#endif /* ENABLE_SMC_STAT */
+
 	switch (smc_fid) {
 	case ARM_SIP_SVC_EXE_STATE_SWITCH: {
 		/* Execution state can be switched only if EL3 is AArch64 */
@@ -95,6 +124,21 @@ static uintptr_t arm_sip_handler(unsigned int smc_fid,
 		/* State switch call */
 		call_count += 1;
 
+#if ENABLE_EHF_STAT
+		/* EHF statistics calls */
+		call_count += EHF_NUM_SMC_CALLS;
+#endif
+
+#if ENABLE_EL3_PROF
+		/* EL3 profiler calls */
+		call_count += EL3_PROF_NUM_SMC_CALLS;
+#endif
+
+#if ENABLE_SMC_STAT
+		/* SMC statistics calls */
+		call_count += SMC_STAT_NUM_SMC_CALLS;
+#endif
+
 		SMC_RET1(handle, call_count);
 
 	case ARM_SIP_SVC_UID:
@@ -26,6 +26,10 @@ ehf_pri_desc_t plat_exceptions[] = {
 #endif
 #if SPM_MM
 	EHF_PRI_DESC(PLAT_PRI_BITS, PLAT_SP_PRI),
+#endif
+#if ENABLE_EL3_PROF
+	/* EL3 profiler priority */
+	EHF_PRI_DESC(PLAT_PRI_BITS, PLAT_EL3_PROF_PRI),
 #endif
 	/* Plaform specific exceptions description */
 #ifdef PLAT_EHF_DESC
@@ -29,6 +29,7 @@
 #pragma weak plat_is_smccc_feature_available
 #pragma weak plat_get_soc_version
 #pragma weak plat_get_soc_revision
+#pragma weak plat_validate_ns_buffer
 
 int32_t plat_get_soc_version(void)
 {
@@ -45,6 +46,16 @@ int32_t plat_is_smccc_feature_available(u_register_t fid __unused)
 	return SMC_ARCH_CALL_NOT_SUPPORTED;
 }
 
+/*
+ * Without knowledge of the Non-secure memory of the platform, no buffer can be
+ * trusted.
+ */
+int plat_validate_ns_buffer(unsigned long long base __unused,
+			    size_t size __unused)
+{
+	return -1;
+}
+
 void bl2_el3_plat_prepare_exit(void)
 {
 }
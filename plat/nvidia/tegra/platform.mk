@@ -74,6 +74,7 @@ override LIBC_SRCS :=	$(addprefix lib/libc/,		\
 			memmove.c			\
 			memset.c			\
 			printf.c			\
+			printf_core.c			\
 			putchar.c			\
 			strrchr.c			\
 			strlen.c			\
@@ -5,113 +5,60 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <assert.h>
+
 #include <platform_def.h>
 
 #include <arch_helpers.h>
 #include <common/bl_common.h>
+#include <common/debug.h>
 #include <lib/xlat_tables/xlat_tables_v2.h>
+#include <plat/common/platform.h>
 
 #include "qemu_private.h"
 
-#define MAP_DEVICE0	MAP_REGION_FLAT(DEVICE0_BASE,			\
-					DEVICE0_SIZE,			\
-					MT_DEVICE | MT_RW | MT_SECURE)
-
-#ifdef DEVICE1_BASE
-#define MAP_DEVICE1	MAP_REGION_FLAT(DEVICE1_BASE,			\
-					DEVICE1_SIZE,			\
-					MT_DEVICE | MT_RW | MT_SECURE)
-#endif
-
-#ifdef DEVICE2_BASE
-#define MAP_DEVICE2	MAP_REGION_FLAT(DEVICE2_BASE,			\
-					DEVICE2_SIZE,			\
-					MT_DEVICE | MT_RO | MT_SECURE)
-#endif
-
-#define MAP_SHARED_RAM	MAP_REGION_FLAT(SHARED_RAM_BASE,		\
-					SHARED_RAM_SIZE,		\
-					MT_DEVICE  | MT_RW | MT_SECURE)
+#if defined(IMAGE_XLAT_TABLES_PREBUILT)
+static void qemu_set_image_attr(unsigned long start, unsigned long limit,
+				uint32_t attr)
+{
+	if (start == limit)
+		return;
 
-#define MAP_BL32_MEM	MAP_REGION_FLAT(BL32_MEM_BASE, BL32_MEM_SIZE,	\
-					MT_MEMORY | MT_RW | MT_SECURE)
-
-#define MAP_NS_DRAM0	MAP_REGION_FLAT(NS_DRAM0_BASE, NS_DRAM0_SIZE,	\
-					MT_MEMORY | MT_RW | MT_NS)
-
-#define MAP_FLASH0	MAP_REGION_FLAT(QEMU_FLASH0_BASE, QEMU_FLASH0_SIZE, \
-					MT_MEMORY | MT_RO | MT_SECURE)
+	if (xlat_change_mem_attributes(start, limit - start, attr) != 0) {
+		ERROR("Failed to map image memory 0x%lx-0x%lx\n", start, limit);
+		panic();
+	}
+}
 
-#define MAP_FLASH1	MAP_REGION_FLAT(QEMU_FLASH1_BASE, QEMU_FLASH1_SIZE, \
-					MT_MEMORY | MT_RO | MT_SECURE)
+/*******************************************************************************
+ * Macro generating the code for the function initializing the mmu for the given
+ * exception level, when the pagetables have been generated at build time from
+ * the platform memory map. The image memory is mapped as read-write data in the
+ * prebuilt tables, only its code and read-only data need to be set up here.
+ * Their attributes can be changed but not their memory type, so coherent memory
+ * isn't supported.
+ ******************************************************************************/
 
-/*
- * Table of regions for various BL stages to map using the MMU.
- * This doesn't include TZRAM as the 'mem_layout' argument passed to
- * arm_configure_mmu_elx() will give the available subset of that,
- */
-#ifdef IMAGE_BL1
-static const mmap_region_t plat_qemu_mmap[] = {
-	MAP_FLASH0,
-	MAP_FLASH1,
-	MAP_SHARED_RAM,
-	MAP_DEVICE0,
-#ifdef MAP_DEVICE1
-	MAP_DEVICE1,
-#endif
-#ifdef MAP_DEVICE2
-	MAP_DEVICE2,
-#endif
-	{0}
-};
-#endif
-#ifdef IMAGE_BL2
-static const mmap_region_t plat_qemu_mmap[] = {
-	MAP_FLASH0,
-	MAP_FLASH1,
-	MAP_SHARED_RAM,
-	MAP_DEVICE0,
-#ifdef MAP_DEVICE1
-	MAP_DEVICE1,
-#endif
-#ifdef MAP_DEVICE2
-	MAP_DEVICE2,
-#endif
-	MAP_NS_DRAM0,
-#if SPM_MM
-	QEMU_SP_IMAGE_MMAP,
-#else
-	MAP_BL32_MEM,
-#endif
-	{0}
-};
-#endif
-#ifdef IMAGE_BL31
-static const mmap_region_t plat_qemu_mmap[] = {
-	MAP_SHARED_RAM,
-	MAP_DEVICE0,
-#ifdef MAP_DEVICE1
-	MAP_DEVICE1,
-#endif
-#if SPM_MM
-	QEMU_SPM_BUF_EL3_MMAP,
+#define DEFINE_CONFIGURE_MMU_EL(_el)					\
+	void qemu_configure_mmu_##_el(unsigned long total_base,	\
+				   unsigned long total_size,		\
+				   unsigned long code_start,		\
+				   unsigned long code_limit,		\
+				   unsigned long ro_start,		\
+				   unsigned long ro_limit,		\
+				   unsigned long coh_start,		\
+				   unsigned long coh_limit)		\
+	{								\
+		assert(coh_start == coh_limit);				\
+		init_xlat_tables();					\
+		qemu_set_image_attr(code_start, code_limit,		\
+				    MT_CODE | MT_SECURE);		\
+		qemu_set_image_attr(ro_start, ro_limit,			\
+				    MT_RO_DATA | MT_SECURE);		\
+									\
+		enable_mmu_##_el(0);					\
+	}
 #else
-	MAP_BL32_MEM,
-#endif
-	{0}
-};
-#endif
-#ifdef IMAGE_BL32
-static const mmap_region_t plat_qemu_mmap[] = {
-	MAP_SHARED_RAM,
-	MAP_DEVICE0,
-#ifdef MAP_DEVICE1
-	MAP_DEVICE1,
-#endif
-	{0}
-};
-#endif
-
 /*******************************************************************************
  * Macro generating the code for the function setting up the pagetables as per
  * the platform memory map & initialize the mmu, for the given exception level
@@ -144,6 +91,7 @@ static const mmap_region_t plat_qemu_mmap[] = {
 									\
 		enable_mmu_##_el(0);					\
 	}
+#endif /* IMAGE_XLAT_TABLES_PREBUILT */
 
 /* Define EL1 and EL3 variants of the function initialising the MMU */
 #ifdef __aarch64__
@@ -154,3 +102,20 @@ DEFINE_CONFIGURE_MMU_EL(svc_mon)
 #endif
 
 
+
+/*
+ * Check that a buffer passed by the Non-secure world lies entirely within the
+ * Non-secure DRAM.
+ */
+int plat_validate_ns_buffer(unsigned long long base, size_t size)
+{
+	unsigned long long end = base + size;
+
+	if ((size == 0U) || (end < base))
+		return -1;
+
+	if ((base >= NS_DRAM0_BASE) && (end <= (NS_DRAM0_BASE + NS_DRAM0_SIZE)))
+		return 0;
+
+	return -1;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2020, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+
+#include <common/debug.h>
+#include <common/runtime_svc.h>
+#include <lib/el3_prof.h>
+
+/*
+ * This function handles the QEMU SiP calls. The EL3 profiler calls, with the
+ * same function IDs as on Arm platforms, are the only ones.
+ */
+static uintptr_t qemu_sip_handler(unsigned int smc_fid,
+				  u_register_t x1,
+				  u_register_t x2,
+				  u_register_t x3,
+				  u_register_t x4,
+				  void *cookie,
+				  void *handle,
+				  u_register_t flags)
+{
+#if ENABLE_EL3_PROF
+	if (is_el3_prof_fid(smc_fid)) {
+		return el3_prof_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
+					    handle, flags);
+	}
+#endif /* ENABLE_EL3_PROF */
+
+	WARN("Unimplemented QEMU SiP Service Call: 0x%x\n", smc_fid);
+	SMC_RET1(handle, SMC_UNK);
+}
+
+/* Define a runtime service descriptor for fast SMC calls */
+DECLARE_RT_SVC(
+	qemu_sip_svc,
+	OEN_SIP_START,
+	OEN_SIP_END,
+	SMC_TYPE_FAST,
+	NULL,
+	qemu_sip_handler
+);
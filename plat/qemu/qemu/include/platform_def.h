@@ -102,6 +102,10 @@
 #define PLAT_QEMU_HOLD_STATE_WAIT	0
 #define PLAT_QEMU_HOLD_STATE_GO		1
 
+/* Boot instrumentation log, in the upper half of the shared RAM */
+#define PLAT_BOOT_INSTR_BASE		(SHARED_RAM_BASE + 0x800)
+#define PLAT_BOOT_INSTR_SIZE		0x800
+
 #define BL_RAM_BASE			(SHARED_RAM_BASE + SHARED_RAM_SIZE)
 #define BL_RAM_SIZE			(SEC_SRAM_SIZE - SHARED_RAM_SIZE)
 
@@ -170,8 +174,14 @@
 
 #define PLAT_PHY_ADDR_SPACE_SIZE	(1ULL << 32)
 #define PLAT_VIRT_ADDR_SPACE_SIZE	(1ULL << 32)
+#if PLAT_XLAT_TABLES_DYNAMIC
+/* Room for the dynamic regions of BL31, e.g. the buffers of the EL3 profiler */
+#define MAX_MMAP_REGIONS		12
+#define MAX_XLAT_TABLES			8
+#else
 #define MAX_MMAP_REGIONS		11
 #define MAX_XLAT_TABLES			6
+#endif
 #define MAX_IO_DEVICES			4
 #define MAX_IO_HANDLES			4
 
@@ -222,6 +232,9 @@
 #define QEMU_IRQ_SEC_SGI_6		14
 #define QEMU_IRQ_SEC_SGI_7		15
 
+/* PMU overflow interrupt, taken in EL3 by the EL3 profiler */
+#define QEMU_IRQ_PMU			23
+
 /******************************************************************************
  * On a GICv2 system, the Group 1 secure interrupts are treated as Group 0
  * interrupts.
@@ -246,6 +259,15 @@
 
 #define PLATFORM_G0_PROPS(grp)
 
+/*
+ * Priorities of the EL3 exceptions, when EL3_EXCEPTION_HANDLING is enabled.
+ * The EL3 profiler only makes the PMU interrupt an EL3 interrupt while it
+ * samples.
+ */
+#define PLAT_PRI_BITS			3
+#define PLAT_EL3_PROF_PRI		0x50
+#define PLAT_EL3_PROF_PMU_IRQ		QEMU_IRQ_PMU
+
 /*
  * DT related constants
  */
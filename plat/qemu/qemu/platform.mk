@@ -46,6 +46,7 @@ endif
 
 PLAT_BL_COMMON_SOURCES	:=	${PLAT_QEMU_COMMON_PATH}/qemu_common.c			\
 				${PLAT_QEMU_COMMON_PATH}/qemu_console.c		  \
+				${PLAT_QEMU_COMMON_PATH}/qemu_mmap.c			\
 				drivers/arm/pl011/${ARCH}/pl011_console.S
 
 include lib/xlat_tables_v2/xlat_tables.mk
@@ -168,6 +169,31 @@ BL31_SOURCES		+=	lib/cpus/aarch64/aem_generic.S		\
 				${PLAT_QEMU_COMMON_PATH}/aarch64/plat_helpers.S	\
 				${PLAT_QEMU_COMMON_PATH}/qemu_bl31_setup.c		\
 				${QEMU_GIC_SOURCES}
+
+ifeq (${EL3_EXCEPTION_HANDLING},1)
+BL31_SOURCES		+=	plat/common/aarch64/plat_ehf.c
+endif
+
+# The EL3 profiler takes the PMU interrupt as a Group 0 interrupt in EL3, which
+# the GICv2 driver of QEMU doesn't support, and its calls are SiP calls.
+ifeq (${ENABLE_EL3_PROF},1)
+ifneq (${QEMU_USE_GIC_DRIVER}, QEMU_GICV3)
+$(error "ENABLE_EL3_PROF requires QEMU_USE_GIC_DRIVER=QEMU_GICV3 on QEMU")
+endif
+BL31_SOURCES		+=	${PLAT_QEMU_COMMON_PATH}/qemu_sip_svc.c
+BL31_CPPFLAGS		+=	-DPLAT_XLAT_TABLES_DYNAMIC
+endif
+
+# The translation tables of BL31 can be generated at build time from its memory
+# map. BL31 is mapped as normal memory in them, so it can't use coherent memory.
+ifeq (${XLAT_TABLES_PREBUILT},1)
+USE_COHERENT_MEM	:=	0
+ifeq (${USE_COHERENT_MEM},1)
+$(error "XLAT_TABLES_PREBUILT requires USE_COHERENT_MEM=0 on QEMU")
+endif
+BL31_XLAT_MMAP_SOURCES	:=	${PLAT_QEMU_COMMON_PATH}/qemu_mmap.c
+BL31_XLAT_MMAP		:=	plat_qemu_mmap
+endif
 endif
 
 # Add the build options to pack Trusted OS Extra1 and Trusted OS Extra2 images
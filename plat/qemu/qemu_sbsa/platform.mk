@@ -32,6 +32,7 @@ PLAT_INCLUDES		+=	-Iinclude/plat/arm/common/${ARCH}
 
 PLAT_BL_COMMON_SOURCES	:=	${PLAT_QEMU_COMMON_PATH}/qemu_common.c		\
 				${PLAT_QEMU_COMMON_PATH}/qemu_console.c		\
+				${PLAT_QEMU_COMMON_PATH}/qemu_mmap.c		\
 				drivers/arm/pl011/${ARCH}/pl011_console.S
 
 include lib/xlat_tables_v2/xlat_tables.mk
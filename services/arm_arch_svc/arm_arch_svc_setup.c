@@ -148,3 +148,32 @@ DECLARE_RT_SVC(
 		NULL,
 		arm_arch_svc_smc_handler
 );
+
+#if SMC_FID_FAST_PATH && \
+	(WORKAROUND_CVE_2017_5715 || WORKAROUND_CVE_2018_3639)
+/*
+ * Handler for the SMCCC_ARCH_WORKAROUND_* calls registered in the SMC function
+ * id fast path. The workarounds have already been applied during entry to EL3
+ * so there is nothing left to do.
+ */
+static uintptr_t arm_arch_svc_wa_smc_handler(uint32_t smc_fid,
+	u_register_t x1,
+	u_register_t x2,
+	u_register_t x3,
+	u_register_t x4,
+	void *cookie,
+	void *handle,
+	u_register_t flags)
+{
+	SMC_RET0(handle);
+}
+
+#if WORKAROUND_CVE_2017_5715
+DECLARE_RT_SVC_FID(smccc_arch_workaround_1, SMCCC_ARCH_WORKAROUND_1,
+		   arm_arch_svc_wa_smc_handler);
+#endif
+#if WORKAROUND_CVE_2018_3639
+DECLARE_RT_SVC_FID(smccc_arch_workaround_2, SMCCC_ARCH_WORKAROUND_2,
+		   arm_arch_svc_wa_smc_handler);
+#endif
+#endif /* SMC_FID_FAST_PATH */
@@ -51,6 +51,16 @@ sdei_entry_t *get_event_entry(sdei_ev_map_t *map)
 	}
 }
 
+/*
+ * Cache of the mappings found for bound interrupts, indexed by a hash of the
+ * interrupt number, for private and shared mappings. An entry is only a hint
+ * and is used only if the mapping is still bound to the same interrupt, so it
+ * doesn't need to be invalidated when an interrupt is released.
+ */
+static sdei_ev_map_t *sdei_intr_cache[SDEI_MAP_IDX_MAX_][SDEI_INTR_CACHE_SIZE];
+
+#define SDEI_INTR_CACHE_IDX(_intr)	((_intr) & (SDEI_INTR_CACHE_SIZE - 1U))
+
 /*
  * Find event mapping for a given interrupt number: On success, returns pointer
  * to the event mapping. On error, returns NULL.
@@ -58,18 +68,61 @@ sdei_entry_t *get_event_entry(sdei_ev_map_t *map)
 sdei_ev_map_t *find_event_map_by_intr(unsigned int intr_num, bool shared)
 {
 	const sdei_mapping_t *mapping;
-	sdei_ev_map_t *map;
+	sdei_ev_map_t *map, **cached;
 	unsigned int i;
 
+	cached = &sdei_intr_cache[shared ? SDEI_MAP_IDX_SHRD_ : SDEI_MAP_IDX_PRIV_]
+			[SDEI_INTR_CACHE_IDX(intr_num)];
+
+	/*
+	 * Free dynamic mappings all have SDEI_DYN_IRQ as interrupt, and the
+	 * first one must be returned, so they aren't cached.
+	 */
+	if (intr_num != SDEI_DYN_IRQ) {
+		map = *cached;
+		if ((map != NULL) && (map->intr == intr_num))
+			return map;
+	}
+
 	/*
 	 * Look for a match in private and shared mappings, as requested. This
-	 * is a linear search. However, if the mappings are required to be
-	 * sorted, for large maps, we could consider binary search.
+	 * is a linear search, only done the first time an interrupt is looked
+	 * up or when it collides with another one in the cache.
 	 */
 	mapping = shared ? SDEI_SHARED_MAPPING() : SDEI_PRIVATE_MAPPING();
 	iterate_mapping(mapping, i, map) {
-		if (map->intr == intr_num)
+		if (map->intr == intr_num) {
+			if (intr_num != SDEI_DYN_IRQ)
+				*cached = map;
+
 			return map;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Find event mapping for a given event number in the given mapping, which is
+ * sorted by event number.
+ */
+static sdei_ev_map_t *find_event_map_in(const sdei_mapping_t *mapping,
+		int ev_num)
+{
+	sdei_ev_map_t *map;
+	size_t low = 0U, high = mapping->num_maps;
+
+	while (low < high) {
+		size_t mid = low + ((high - low) / 2U);
+
+		map = &mapping->map[mid];
+		if (map->ev_num == ev_num)
+			return map;
+
+		if (map->ev_num < ev_num)
+			low = mid + 1U;
+		else
+			high = mid;
 	}
 
 	return NULL;
@@ -83,18 +136,16 @@ sdei_ev_map_t *find_event_map(int ev_num)
 {
 	const sdei_mapping_t *mapping;
 	sdei_ev_map_t *map;
-	unsigned int i, j;
+	unsigned int i;
 
 	/*
-	 * Iterate through mappings to find a match. This is a linear search.
-	 * However, if the mappings are required to be sorted, for large maps,
-	 * we could consider binary search.
+	 * The mappings are sorted by event number, which is checked by
+	 * sdei_init(), so a binary search is done in each of them.
 	 */
 	for_each_mapping_type(i, mapping) {
-		iterate_mapping(mapping, j, map) {
-			if (map->ev_num == ev_num)
-				return map;
-		}
+		map = find_event_map_in(mapping, ev_num);
+		if (map != NULL)
+			return map;
 	}
 
 	return NULL;
@@ -279,6 +279,8 @@ static void setup_ns_dispatch(sdei_ev_map_t *map, sdei_entry_t *se,
 #endif
 
 	disp_ctx->dispatch_jmp = dispatch_jmp;
+
+	sdei_instr_capture(SDEI_INSTR_DISPATCH);
 }
 
 /* Handle a triggered SDEI interrupt while events were masked on this PE */
@@ -350,6 +352,8 @@ int sdei_intr_handler(uint32_t intr_raw, uint32_t flags, void *handle,
 	jmp_buf dispatch_jmp;
 	const uint64_t mpidr = read_mpidr_el1();
 
+	sdei_instr_capture(SDEI_INSTR_INTR_ENTER);
+
 	/*
 	 * To handle an event, the following conditions must be true:
 	 *
@@ -508,6 +512,8 @@ int sdei_intr_handler(uint32_t intr_raw, uint32_t flags, void *handle,
 	}
 	plat_ic_end_of_interrupt(intr_raw);
 
+	sdei_instr_capture(SDEI_INSTR_RESUME);
+
 	return 0;
 }
 
@@ -592,6 +598,8 @@ int sdei_dispatch_event(int ev_num)
 	 */
 	ehf_deactivate_priority(sdei_event_priority(map));
 
+	sdei_instr_capture(SDEI_INSTR_RESUME);
+
 	return 0;
 }
 
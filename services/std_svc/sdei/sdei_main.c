@@ -40,6 +40,11 @@ CASSERT(PLAT_SDEI_CRITICAL_PRI < PLAT_SDEI_NORMAL_PRI,
 
 static unsigned int num_dyn_priv_slots, num_dyn_shrd_slots;
 
+#if ENABLE_RUNTIME_INSTRUMENTATION
+PMF_REGISTER_SERVICE_SMC(sdei_svc, PMF_SDEI_SVC_ID,
+	SDEI_INSTR_TOTAL_IDS, PMF_STORE_ENABLE)
+#endif
+
 /* Initialise SDEI map entries */
 static void init_map(sdei_ev_map_t *map)
 {
@@ -94,23 +99,35 @@ static void *sdei_cpu_wakeup_init(const void *arg)
 	return 0;
 }
 
+/*
+ * Event mappings are looked up by binary search, so panic if the platform
+ * mappings aren't sorted by increasing event number.
+ */
+static void check_map_sorted(sdei_ev_map_t *map, int *ev_num_so_far)
+{
+	if ((*ev_num_so_far >= 0) && (map->ev_num <= *ev_num_so_far)) {
+		ERROR("SDEI: event %d mapped out of order\n", map->ev_num);
+		panic();
+	}
+
+	*ev_num_so_far = map->ev_num;
+}
+
 /* Initialise an SDEI class */
 static void sdei_class_init(sdei_class_t class)
 {
 	unsigned int i;
 	bool zero_found __unused = false;
-	int ev_num_so_far __unused;
+	int ev_num_so_far;
 	sdei_ev_map_t *map;
 
 	/* Sanity check and configuration of shared events */
 	ev_num_so_far = -1;
 	for_each_shared_map(i, map) {
-#if ENABLE_ASSERTIONS
-		/* Ensure mappings are sorted */
-		assert((ev_num_so_far < 0) || (map->ev_num > ev_num_so_far));
-
-		ev_num_so_far = map->ev_num;
+		/* Mappings must be sorted for find_event_map() */
+		check_map_sorted(map, &ev_num_so_far);
 
+#if ENABLE_ASSERTIONS
 		/* Event 0 must not be shared */
 		assert(map->ev_num != SDEI_EVENT_0);
 
@@ -139,6 +156,9 @@ static void sdei_class_init(sdei_class_t class)
 		} else {
 			/* Shared mappings must be bound to shared interrupt */
 			assert(plat_ic_is_spi(map->intr) != 0);
+
+			/* Only one mapping can be bound to an interrupt */
+			assert(find_event_map_by_intr(map->intr, true) == map);
 			set_map_bound(map);
 		}
 
@@ -148,12 +168,10 @@ static void sdei_class_init(sdei_class_t class)
 	/* Sanity check and configuration of private events for this CPU */
 	ev_num_so_far = -1;
 	for_each_private_map(i, map) {
-#if ENABLE_ASSERTIONS
-		/* Ensure mappings are sorted */
-		assert((ev_num_so_far < 0) || (map->ev_num > ev_num_so_far));
-
-		ev_num_so_far = map->ev_num;
+		/* Mappings must be sorted for find_event_map() */
+		check_map_sorted(map, &ev_num_so_far);
 
+#if ENABLE_ASSERTIONS
 		if (map->ev_num == SDEI_EVENT_0) {
 			zero_found = true;
 
@@ -210,6 +228,10 @@ static void sdei_class_init(sdei_class_t class)
 				 * interrupt.
 				 */
 				assert(plat_ic_is_ppi((unsigned) map->intr) != 0);
+
+				/* Only one mapping can be bound to an interrupt */
+				assert(find_event_map_by_intr(map->intr, false)
+						== map);
 				set_map_bound(map);
 			}
 		}
@@ -992,6 +1014,7 @@ uint64_t sdei_smc_handler(uint32_t smc_fid,
 		/* Fallthrough */
 
 	case SDEI_EVENT_COMPLETE:
+		sdei_instr_smc_entry(SDEI_INSTR_COMPLETE);
 		SDEI_LOG("> COMPLETE(r:%u sta/ep:%llx):%lx\n",
 				(unsigned int) resume, x1, read_mpidr_el1());
 		ret = sdei_event_complete(resume, x1);
@@ -1076,6 +1099,7 @@ uint64_t sdei_smc_handler(uint32_t smc_fid,
 		SMC_RET1(ctx, ret);
 
 	case SDEI_EVENT_SIGNAL:
+		sdei_instr_smc_entry(SDEI_INSTR_SIGNAL);
 		SDEI_LOG("> SIGNAL(e:%d t:%llx)\n", ev_num, x2);
 		ret = sdei_signal(ev_num, x2);
 		SDEI_LOG("< SIGNAL:%lld\n", ret);
@@ -16,6 +16,7 @@
 #include <common/debug.h>
 #include <context.h>
 #include <lib/el3_runtime/context_mgmt.h>
+#include <lib/el3_runtime/cpu_data.h>
 #include <lib/spinlock.h>
 #include <lib/utils_def.h>
 #include <plat/common/platform.h>
@@ -83,6 +84,9 @@
 #define for_each_shared_map(_i, _map) \
 	iterate_mapping(SDEI_SHARED_MAPPING(), _i, _map)
 
+/* Number of entries of the interrupt lookup cache, must be a power of 2 */
+#define SDEI_INTR_CACHE_SIZE		32U
+
 /* SDEI_FEATURES */
 #define SDEI_FEATURE_BIND_SLOTS		0U
 #define BIND_SLOTS_MASK			0xffffU
@@ -214,6 +218,23 @@ typedef enum {
 	SDEI_CRITICAL
 } sdei_class_t;
 
+/* Record the current time as the given SDEI instrumentation timestamp */
+static inline void sdei_instr_capture(unsigned int tid)
+{
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(sdei_svc, tid, PMF_NO_CACHE_MAINT);
+#endif
+}
+
+/* Record the SMC entry time as the given SDEI instrumentation timestamp */
+static inline void sdei_instr_smc_entry(unsigned int tid)
+{
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_WRITE_TIMESTAMP(sdei_svc, tid, PMF_NO_CACHE_MAINT,
+			get_cpu_data(cpu_data_pmf_ts[CPU_DATA_PMF_TS0_IDX]));
+#endif
+}
+
 static inline void sdei_map_lock(sdei_ev_map_t *map)
 {
 	spin_lock(&map->lock);
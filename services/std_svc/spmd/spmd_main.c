@@ -14,6 +14,9 @@
 #include <common/debug.h>
 #include <common/runtime_svc.h>
 #include <lib/el3_runtime/context_mgmt.h>
+#include <lib/el3_runtime/cpu_data.h>
+#include <lib/el3_runtime/pubsub_events.h>
+#include <lib/pmf/pmf.h>
 #include <lib/smccc.h>
 #include <lib/spinlock.h>
 #include <lib/utils.h>
@@ -332,6 +335,49 @@ int spmd_setup(void)
 	return rc;
 }
 
+#if ENABLE_RUNTIME_INSTRUMENTATION
+PMF_REGISTER_SERVICE_SMC(spmd_svc, PMF_SPMD_SVC_ID,
+	SPMD_INSTR_TOTAL_IDS, PMF_STORE_ENABLE)
+#endif
+
+/*******************************************************************************
+ * Record the SMC entry time of a call forwarded to the other security state
+ ******************************************************************************/
+static void spmd_instr_forward_enter(bool secure_origin)
+{
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	if (secure_origin) {
+		PMF_WRITE_TIMESTAMP(spmd_svc,
+		    SPMD_INSTR_ENTER_SWD_FWD,
+		    PMF_NO_CACHE_MAINT,
+		    get_cpu_data(cpu_data_pmf_ts[CPU_DATA_PMF_TS0_IDX]));
+	} else {
+		PMF_WRITE_TIMESTAMP(spmd_svc,
+		    SPMD_INSTR_ENTER_NWD_FWD,
+		    PMF_NO_CACHE_MAINT,
+		    get_cpu_data(cpu_data_pmf_ts[CPU_DATA_PMF_TS0_IDX]));
+	}
+#endif
+}
+
+/*******************************************************************************
+ * Record the time at which the context of the other security state is ready
+ ******************************************************************************/
+static void spmd_instr_forward_exit(bool secure_origin)
+{
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	if (secure_origin) {
+		PMF_CAPTURE_TIMESTAMP(spmd_svc,
+		    SPMD_INSTR_EXIT_SWD_FWD,
+		    PMF_NO_CACHE_MAINT);
+	} else {
+		PMF_CAPTURE_TIMESTAMP(spmd_svc,
+		    SPMD_INSTR_EXIT_NWD_FWD,
+		    PMF_NO_CACHE_MAINT);
+	}
+#endif
+}
+
 /*******************************************************************************
  * Forward SMC to the other security state
  ******************************************************************************/
@@ -346,6 +392,8 @@ static uint64_t spmd_smc_forward(uint32_t smc_fid,
 	unsigned int secure_state_in = (secure_origin) ? SECURE : NON_SECURE;
 	unsigned int secure_state_out = (!secure_origin) ? SECURE : NON_SECURE;
 
+	spmd_instr_forward_enter(secure_origin);
+
 	/* Save incoming security state */
 	cm_el1_sysregs_context_save(secure_state_in);
 #if SPMD_SPM_AT_SEL2
@@ -359,10 +407,64 @@ static uint64_t spmd_smc_forward(uint32_t smc_fid,
 #endif
 	cm_set_next_eret_context(secure_state_out);
 
+	spmd_instr_forward_exit(secure_origin);
+
+	SMC_RET8(cm_get_context(secure_state_out), smc_fid, x1, x2, x3, x4,
+			SMC_GET_GP(handle, CTX_GPREG_X5),
+			SMC_GET_GP(handle, CTX_GPREG_X6),
+			SMC_GET_GP(handle, CTX_GPREG_X7));
+}
+
+/*******************************************************************************
+ * Forward a direct message or FFA_MSG_RUN to the other security state.
+ *
+ * With SPMD_FAST_FORWARD, the SPMC at S-EL2 saves and restores the S-EL1
+ * context of the partitions it runs, so only its S-EL2 context is switched on
+ * this path. The S-EL1 registers are neither saved nor restored: the SPMC is
+ * entered with the non-secure EL1 values in place, and the copy of the S-EL1
+ * context held by EL3 isn't updated when it exits. The SPMC must therefore not
+ * rely on the S-EL1 registers being preserved by EL3 across these calls. All
+ * the other paths to and from the SPMC still switch the S-EL1 context. The
+ * non-secure EL1 and EL2 contexts are switched as in spmd_smc_forward(), so no
+ * secure state is exposed to the normal world.
+ ******************************************************************************/
+static uint64_t spmd_smc_forward_msg(uint32_t smc_fid,
+				     bool secure_origin,
+				     uint64_t x1,
+				     uint64_t x2,
+				     uint64_t x3,
+				     uint64_t x4,
+				     void *handle)
+{
+#if SPMD_FAST_FORWARD
+	unsigned int secure_state_out = (!secure_origin) ? SECURE : NON_SECURE;
+
+	spmd_instr_forward_enter(secure_origin);
+
+	if (secure_origin) {
+		cm_el2_sysregs_context_save(SECURE);
+		PUBLISH_EVENT(cm_exited_secure_world);
+
+		cm_el1_sysregs_context_restore(NON_SECURE);
+		cm_el2_sysregs_context_restore(NON_SECURE);
+	} else {
+		cm_el1_sysregs_context_save(NON_SECURE);
+		cm_el2_sysregs_context_save(NON_SECURE);
+
+		cm_el2_sysregs_context_restore(SECURE);
+		PUBLISH_EVENT(cm_entering_secure_world);
+	}
+	cm_set_next_eret_context(secure_state_out);
+
+	spmd_instr_forward_exit(secure_origin);
+
 	SMC_RET8(cm_get_context(secure_state_out), smc_fid, x1, x2, x3, x4,
 			SMC_GET_GP(handle, CTX_GPREG_X5),
 			SMC_GET_GP(handle, CTX_GPREG_X6),
 			SMC_GET_GP(handle, CTX_GPREG_X7));
+#else
+	return spmd_smc_forward(smc_fid, secure_origin, x1, x2, x3, x4, handle);
+#endif
 }
 
 /*******************************************************************************
@@ -437,7 +539,7 @@ uint64_t spmd_smc_handler(uint32_t smc_fid,
 	/* Determine which security state this SMC originated from */
 	secure_origin = is_caller_secure(flags);
 
-	INFO("SPM: 0x%x 0x%llx 0x%llx 0x%llx 0x%llx 0x%llx 0x%llx 0x%llx\n",
+	VERBOSE("SPM: 0x%x 0x%llx 0x%llx 0x%llx 0x%llx 0x%llx 0x%llx 0x%llx\n",
 	     smc_fid, x1, x2, x3, x4, SMC_GET_GP(handle, CTX_GPREG_X5),
 	     SMC_GET_GP(handle, CTX_GPREG_X6),
 	     SMC_GET_GP(handle, CTX_GPREG_X7));
@@ -547,7 +649,7 @@ uint64_t spmd_smc_handler(uint32_t smc_fid,
 				FFA_PARAM_MBZ);
 		} else {
 			/* Forward direct message to the other world */
-			return spmd_smc_forward(smc_fid, secure_origin,
+			return spmd_smc_forward_msg(smc_fid, secure_origin,
 				x1, x2, x3, x4, handle);
 		}
 		break; /* Not reached */
@@ -557,11 +659,18 @@ uint64_t spmd_smc_handler(uint32_t smc_fid,
 			spmd_spm_core_sync_exit(0);
 		} else {
 			/* Forward direct message to the other world */
-			return spmd_smc_forward(smc_fid, secure_origin,
+			return spmd_smc_forward_msg(smc_fid, secure_origin,
 				x1, x2, x3, x4, handle);
 		}
 		break; /* Not reached */
 
+	case FFA_MSG_SEND_DIRECT_REQ_SMC64:
+	case FFA_MSG_SEND_DIRECT_RESP_SMC64:
+		/* Forward direct message to the other world */
+		return spmd_smc_forward_msg(smc_fid, secure_origin,
+					    x1, x2, x3, x4, handle);
+		break; /* Not reached */
+
 	case FFA_RX_RELEASE:
 	case FFA_RXTX_MAP_SMC32:
 	case FFA_RXTX_MAP_SMC64:
@@ -581,10 +690,13 @@ uint64_t spmd_smc_handler(uint32_t smc_fid,
 						     FFA_ERROR_NOT_SUPPORTED);
 		}
 
+		if (smc_fid == FFA_MSG_RUN) {
+			return spmd_smc_forward_msg(smc_fid, secure_origin,
+						    x1, x2, x3, x4, handle);
+		}
+
 		/* Fall through to forward the call to the other world */
 	case FFA_MSG_SEND:
-	case FFA_MSG_SEND_DIRECT_REQ_SMC64:
-	case FFA_MSG_SEND_DIRECT_RESP_SMC64:
 	case FFA_MEM_DONATE_SMC32:
 	case FFA_MEM_DONATE_SMC64:
 	case FFA_MEM_LEND_SMC32:
@@ -637,3 +749,32 @@ uint64_t spmd_smc_handler(uint32_t smc_fid,
 		return spmd_ffa_error_return(handle, FFA_ERROR_NOT_SUPPORTED);
 	}
 }
+
+#if SMC_FID_FAST_PATH
+/*******************************************************************************
+ * Entry point for the FF-A calls registered in the SMC function id fast path.
+ * These reach the SPM dispatcher without going through the Standard Service
+ * SMC handler.
+ ******************************************************************************/
+static uintptr_t spmd_fast_smc_handler(uint32_t smc_fid,
+				       u_register_t x1,
+				       u_register_t x2,
+				       u_register_t x3,
+				       u_register_t x4,
+				       void *cookie,
+				       void *handle,
+				       u_register_t flags)
+{
+	return spmd_smc_handler(smc_fid, x1, x2, x3, x4, cookie, handle, flags);
+}
+
+DECLARE_RT_SVC_FID(ffa_msg_send_direct_req_smc32,
+		   FFA_MSG_SEND_DIRECT_REQ_SMC32, spmd_fast_smc_handler);
+DECLARE_RT_SVC_FID(ffa_msg_send_direct_req_smc64,
+		   FFA_MSG_SEND_DIRECT_REQ_SMC64, spmd_fast_smc_handler);
+DECLARE_RT_SVC_FID(ffa_msg_send_direct_resp_smc32,
+		   FFA_MSG_SEND_DIRECT_RESP_SMC32, spmd_fast_smc_handler);
+DECLARE_RT_SVC_FID(ffa_msg_send_direct_resp_smc64,
+		   FFA_MSG_SEND_DIRECT_RESP_SMC64, spmd_fast_smc_handler);
+DECLARE_RT_SVC_FID(ffa_msg_run, FFA_MSG_RUN, spmd_fast_smc_handler);
+#endif /* SMC_FID_FAST_PATH */
@@ -67,10 +67,10 @@ static int32_t std_svc_setup(void)
 }
 
 /*
- * Top-level Standard Service SMC handler. This handler will in turn dispatch
- * calls to PSCI SMC handler
+ * PSCI SMC handler wrapper adding the runtime instrumentation around the call
+ * to the PSCI library.
  */
-static uintptr_t std_svc_smc_handler(uint32_t smc_fid,
+static uintptr_t std_svc_psci_smc_handler(uint32_t smc_fid,
 			     u_register_t x1,
 			     u_register_t x2,
 			     u_register_t x3,
@@ -79,35 +79,52 @@ static uintptr_t std_svc_smc_handler(uint32_t smc_fid,
 			     void *handle,
 			     u_register_t flags)
 {
-	/*
-	 * Dispatch PSCI calls to PSCI SMC handler and return its return
-	 * value
-	 */
-	if (is_psci_fid(smc_fid)) {
-		uint64_t ret;
+	uint64_t ret;
 
 #if ENABLE_RUNTIME_INSTRUMENTATION
 
-		/*
-		 * Flush cache line so that even if CPU power down happens
-		 * the timestamp update is reflected in memory.
-		 */
-		PMF_WRITE_TIMESTAMP(rt_instr_svc,
-		    RT_INSTR_ENTER_PSCI,
-		    PMF_CACHE_MAINT,
-		    get_cpu_data(cpu_data_pmf_ts[CPU_DATA_PMF_TS0_IDX]));
+	/*
+	 * Flush cache line so that even if CPU power down happens
+	 * the timestamp update is reflected in memory.
+	 */
+	PMF_WRITE_TIMESTAMP(rt_instr_svc,
+	    RT_INSTR_ENTER_PSCI,
+	    PMF_CACHE_MAINT,
+	    get_cpu_data(cpu_data_pmf_ts[CPU_DATA_PMF_TS0_IDX]));
 #endif
 
-		ret = psci_smc_handler(smc_fid, x1, x2, x3, x4,
-		    cookie, handle, flags);
+	ret = psci_smc_handler(smc_fid, x1, x2, x3, x4,
+	    cookie, handle, flags);
 
 #if ENABLE_RUNTIME_INSTRUMENTATION
-		PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
-		    RT_INSTR_EXIT_PSCI,
-		    PMF_NO_CACHE_MAINT);
+	PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+	    RT_INSTR_EXIT_PSCI,
+	    PMF_NO_CACHE_MAINT);
 #endif
 
-		SMC_RET1(handle, ret);
+	SMC_RET1(handle, ret);
+}
+
+/*
+ * Top-level Standard Service SMC handler. This handler will in turn dispatch
+ * calls to PSCI SMC handler
+ */
+static uintptr_t std_svc_smc_handler(uint32_t smc_fid,
+			     u_register_t x1,
+			     u_register_t x2,
+			     u_register_t x3,
+			     u_register_t x4,
+			     void *cookie,
+			     void *handle,
+			     u_register_t flags)
+{
+	/*
+	 * Dispatch PSCI calls to PSCI SMC handler and return its return
+	 * value
+	 */
+	if (is_psci_fid(smc_fid)) {
+		return std_svc_psci_smc_handler(smc_fid, x1, x2, x3, x4,
+						cookie, handle, flags);
 	}
 
 #if SPM_MM
@@ -171,3 +188,15 @@ DECLARE_RT_SVC(
 		std_svc_setup,
 		std_svc_smc_handler
 );
+
+/*
+ * Register the hot Standard Service Calls in the SMC function id fast path.
+ * The FF-A calls used for direct messaging are registered by the SPM
+ * dispatcher itself.
+ */
+DECLARE_RT_SVC_FID(psci_cpu_suspend_aarch32, PSCI_CPU_SUSPEND_AARCH32,
+		   std_svc_psci_smc_handler);
+#ifdef __aarch64__
+DECLARE_RT_SVC_FID(psci_cpu_suspend_aarch64, PSCI_CPU_SUSPEND_AARCH64,
+		   std_svc_psci_smc_handler);
+#endif
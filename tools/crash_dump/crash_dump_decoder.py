@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+"""
+Decoder of the crash dump region written by BL31 when built with CRASH_DUMP=1.
+
+The region is read from a raw memory dump. The ELF file of BL31 is used to
+symbolize the addresses of the dump and to resolve the format strings of the
+log ring records. The layout of the region is the one described in
+include/lib/crash_dump.h.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                '..', 'log_ring'))
+from log_ring_decoder import Elf, LOG_REC, decode_records  # noqa: E402
+
+CRASH_DUMP_MAGIC = 0x44434654
+CRASH_DUMP_LOG_MAGIC = 0x474c4654
+CRASH_DUMP_CPU_SIZE = 0x200
+CRASH_DUMP_BT_DEPTH = 16
+
+REASONS = {
+    1: 'panic',
+    2: 'unhandled exception',
+    3: 'unhandled interrupt',
+    4: 'panic while handling a lower EL exception',
+}
+
+# Named 64-bit fields of a CPU record, following x0 - x30
+SYSREGS = ['sp_el0', 'elr_el3', 'spsr_el3', 'esr_el3', 'far_el3', 'scr_el3',
+           'sctlr_el3', 'elr_el1', 'spsr_el1', 'esr_el1', 'far_el1',
+           'sctlr_el1', 'sp_el1']
+
+def decode_cpu(elf, idx, rec):
+    magic, reason, ts, mpidr = struct.unpack_from('<IIQQ', rec, 0)
+    if magic != CRASH_DUMP_MAGIC:
+        return False
+
+    regs = struct.unpack_from('<31Q', rec, 0x18)
+    sysregs = struct.unpack_from('<%dQ' % len(SYSREGS), rec, 0x110)
+    (depth,) = struct.unpack_from('<Q', rec, 0x178)
+    bt = struct.unpack_from('<%dQ' % CRASH_DUMP_BT_DEPTH, rec, 0x180)
+
+    print('CPU %d (mpidr 0x%x): %s at timestamp %d' %
+          (idx, mpidr, REASONS.get(reason, 'reason %d' % reason), ts))
+    for i, val in enumerate(regs):
+        sym = elf.symbolize(val) if i == 30 else ''
+        print('    %-14s = 0x%016x%s' % ('x%d' % i, val, sym))
+    for name, val in zip(SYSREGS, sysregs):
+        sym = elf.symbolize(val) if name == 'elr_el3' else ''
+        print('    %-14s = 0x%016x%s' % (name, val, sym))
+    if depth > 0:
+        print('  Backtrace:')
+        for i, val in enumerate(bt[:min(depth, CRASH_DUMP_BT_DEPTH)]):
+            print('    %2d: 0x%016x%s' % (i, val, elf.symbolize(val)))
+    print('')
+    return True
+
+
+def decode_log(elf, log):
+    if len(log) < 0x18:
+        return
+    magic, head, size = struct.unpack_from('<IxxxxQQ', log, 0)
+    if magic != CRASH_DUMP_LOG_MAGIC:
+        return
+
+    count = min(size, len(log) - 0x18) // LOG_REC.size
+    if count == 0:
+        return
+
+    # The copy is truncated when the region is smaller than the ring
+    entries = elf.sizes.get('tf_log_ring', count * LOG_REC.size) // \
+        LOG_REC.size
+
+    print('Log ring:')
+    for msg in decode_records(elf, log[0x18:0x18 + count * LOG_REC.size],
+                              head, entries):
+        sys.stdout.write('  ' + msg)
+    print('')
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().split('\n')[0])
+    parser.add_argument('dump', help='raw dump of the crash dump region')
+    parser.add_argument('elf', help='ELF file of BL31 (bl31.elf)')
+    parser.add_argument('-c', '--cores', type=int, required=True,
+                        help='PLATFORM_CORE_COUNT of the platform')
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    with open(args.dump, 'rb') as f:
+        dump = f.read()
+
+    found = False
+    for idx in range(args.cores):
+        rec = dump[idx * CRASH_DUMP_CPU_SIZE:(idx + 1) * CRASH_DUMP_CPU_SIZE]
+        if len(rec) < CRASH_DUMP_CPU_SIZE:
+            break
+        found |= decode_cpu(elf, idx, rec)
+
+    if not found:
+        print('No crash dump found')
+        return 1
+
+    decode_log(elf, dump[args.cores * CRASH_DUMP_CPU_SIZE:])
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+"""
+Decoder of the log ring of a BL image built with ENABLE_LOG_RING=1.
+
+The log ring is read from a raw memory dump of the image, which must cover the
+tf_log_ring, tf_log_ring_head and tf_log_ring_tail symbols. The ELF file of the
+image is used to locate them and to resolve the format strings of the records.
+The layout of the records is the one of tf_log_rec_t in common/tf_log.c.
+"""
+
+import argparse
+import bisect
+import re
+import struct
+import sys
+
+# Log ring record: fmt, ts, level, nargs, args[5], strs[32]
+LOG_REC = struct.Struct('<QQII5Q32s')
+
+LOG_PREFIXES = {
+    10: 'ERROR:   ',
+    20: 'NOTICE:  ',
+    30: 'WARNING: ',
+    40: 'INFO:    ',
+    50: 'VERBOSE: ',
+}
+
+
+class Elf(object):
+    """Minimal reader of a little-endian ELF64 file"""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF' or self.data[4] != 2:
+            raise ValueError('%s is not an ELF64 file' % path)
+
+        (shoff,) = struct.unpack_from('<Q', self.data, 0x28)
+        shentsize, shnum = struct.unpack_from('<HH', self.data, 0x3a)
+        self.sections = []
+        for i in range(shnum):
+            (name, stype, flags, addr, off, size, link, info, align,
+             entsize) = struct.unpack_from('<IIQQQQIIQQ', self.data,
+                                           shoff + i * shentsize)
+            self.sections.append((stype, flags, addr, off, size, link))
+
+        self.symbols = []
+        self.addrs = {}
+        self.sizes = {}
+        for stype, _, _, off, size, link in self.sections:
+            if stype != 2:          # SHT_SYMTAB
+                continue
+            stroff = self.sections[link][3]
+            for i in range(0, size, 24):
+                name, info, _, _, value, ssize = struct.unpack_from(
+                    '<IBBHQQ', self.data, off + i)
+                if (info & 0xf) in (1, 2) and name != 0:
+                    name = self.cstring(stroff + name)
+                    self.symbols.append((value, name))
+                    self.addrs[name] = value
+                    self.sizes[name] = ssize
+        self.symbols.sort()
+        self.sym_addrs = [s[0] for s in self.symbols]
+
+    def cstring(self, off):
+        end = self.data.index(b'\0', off)
+        return self.data[off:end].decode('ascii', 'replace')
+
+    def read_string(self, addr):
+        """Return the string at address `addr` of the image, or None"""
+        for stype, flags, saddr, off, size, _ in self.sections:
+            # Allocated sections which have contents in the file
+            if (flags & 2) and stype != 8 and saddr <= addr < saddr + size:
+                return self.cstring(off + addr - saddr)
+        return None
+
+    def symbolize(self, addr):
+        i = bisect.bisect_right(self.sym_addrs, addr) - 1
+        if i < 0 or addr == 0:
+            return ''
+        value, name = self.symbols[i]
+        return ' <%s+0x%x>' % (name, addr - value)
+
+
+def format_record(fmt, nargs, args, strs):
+    """Format a log record as the printf() of the firmware does"""
+    args = list(args[:nargs])
+
+    def conv(m):
+        flags, width, conv = m.group(1), m.group(2), m.group(4)
+        if conv == '%':
+            return '%'
+        if not args:
+            return m.group(0)
+        val = args.pop(0)
+        if conv in 'di':
+            bits = {0: 32, 1: 64, 2: 64}[min(len(m.group(3)), 2)]
+            if m.group(3) == 'z':
+                bits = 64
+            val &= (1 << bits) - 1
+            if val >> (bits - 1):
+                val -= 1 << bits
+            conv = 'd'
+        elif conv == 's':
+            # String arguments are copied in the record, at offset `val`
+            val = strs[val:].split(b'\0', 1)[0].decode('ascii', 'replace')
+        elif conv == 'p':
+            return ('%' + flags + width + 's') % \
+                (('0x%x' % val) if val else '0')
+        return ('%' + flags + width + conv) % val
+
+    return re.sub(r'%([-0]*)(\d*)(l*|z)([diuxXps%])', conv, fmt)
+
+
+def decode_records(elf, ring, head, entries):
+    """
+    Yield the messages of the records available in `ring`, a copy of the log
+    ring of `entries` records, possibly truncated, oldest first. `head` is the
+    sequence number of the next record to be written.
+    """
+    count = min(len(ring) // LOG_REC.size, entries)
+
+    # Records are in the ring at their sequence number modulo its size
+    for seq in range(max(head - entries, 0), head):
+        if seq % entries >= count:
+            continue
+        fmt_addr, ts, level, nargs, *args, strs = LOG_REC.unpack_from(
+            ring, (seq % entries) * LOG_REC.size)
+        fmt = elf.read_string(fmt_addr)
+        if fmt is None:
+            continue
+        yield '[%d] %s%s' % (ts, LOG_PREFIXES.get(level, ''),
+                             format_record(fmt, nargs, args, strs))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().split('\n')[0])
+    parser.add_argument('dump', nargs='?',
+                        help='raw memory dump covering the log ring')
+    parser.add_argument('elf', help='ELF file of the BL image')
+    parser.add_argument('-b', '--base', type=lambda x: int(x, 0),
+                        help='address of the start of the dump (default: '
+                             'lowest address of the log ring symbols)')
+    parser.add_argument('-r', '--range', action='store_true',
+                        help='print the range of addresses to dump and exit')
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    syms = ['tf_log_ring', 'tf_log_ring_head', 'tf_log_ring_tail']
+    missing = [s for s in syms if s not in elf.addrs]
+    if missing:
+        print('%s: no %s symbol, is the image built with ENABLE_LOG_RING=1?' %
+              (args.elf, missing[0]))
+        return 1
+
+    start = min(elf.addrs[s] for s in syms)
+    end = max(elf.addrs[s] + elf.sizes[s] for s in syms)
+    if args.range:
+        print('0x%x 0x%x' % (start, end))
+        return 0
+    if args.dump is None:
+        parser.error('the dump file is required')
+
+    base = start if args.base is None else args.base
+    with open(args.dump, 'rb') as f:
+        dump = f.read()
+    if base > start or base + len(dump) < end:
+        print('The dump doesn\'t cover the log ring (0x%x - 0x%x)' %
+              (start, end))
+        return 1
+
+    def read_u32(name):
+        return struct.unpack_from('<I', dump, elf.addrs[name] - base)[0]
+
+    head, tail = read_u32('tf_log_ring_head'), read_u32('tf_log_ring_tail')
+    entries = elf.sizes['tf_log_ring'] // LOG_REC.size
+    off = elf.addrs['tf_log_ring'] - base
+    ring = dump[off:off + entries * LOG_REC.size]
+
+    print('Log ring: %d records written, %d not flushed' %
+          (head, (head - tail) & 0xffffffff))
+    for msg in decode_records(elf, ring, head, entries):
+        sys.stdout.write(msg)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
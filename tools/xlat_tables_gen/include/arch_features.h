@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2020, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Host replacement of the architectural feature checks used by the
+ * xlat_tables_v2 library. The features can't be detected at build time, so
+ * the ones enabled in the build configuration are assumed to be present.
+ */
+
+#ifndef ARCH_FEATURES_H
+#define ARCH_FEATURES_H
+
+#include <stdbool.h>
+
+#include <arch_helpers.h>
+
+static inline bool is_armv8_5_bti_present(void)
+{
+	return ENABLE_BTI != 0;
+}
+
+#endif /* ARCH_FEATURES_H */
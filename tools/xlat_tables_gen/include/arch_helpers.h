@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2020, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Host replacement of the architectural helpers used by the xlat_tables_v2
+ * library. The translation tables built by the host tool are never walked by
+ * an MMU, so barriers and cache maintenance operations have no effect.
+ */
+
+#ifndef ARCH_HELPERS_H
+#define ARCH_HELPERS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <arch.h>
+
+static inline void isb(void)
+{
+}
+
+static inline void dsbsy(void)
+{
+}
+
+static inline void dsbish(void)
+{
+}
+
+static inline void dsbishst(void)
+{
+}
+
+void flush_dcache_range(uintptr_t addr, size_t size);
+void clean_dcache_range(uintptr_t addr, size_t size);
+void inv_dcache_range(uintptr_t addr, size_t size);
+bool is_dcache_enabled(void);
+
+#endif /* ARCH_HELPERS_H */
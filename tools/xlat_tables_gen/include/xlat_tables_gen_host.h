@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2020, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Definitions of the firmware libc that the host libc doesn't provide. This
+ * file is included before any other by all the sources of the host tool.
+ */
+
+#ifndef XLAT_TABLES_GEN_HOST_H
+#define XLAT_TABLES_GEN_HOST_H
+
+#include <stdint.h>
+
+typedef long register_t;
+typedef unsigned long u_register_t;
+
+/*
+ * Log messages are printed directly by the tf_log() of the host tool, whatever
+ * the log ring setting of the BL image.
+ */
+#undef ENABLE_LOG_RING
+#define ENABLE_LOG_RING		0
+
+#endif /* XLAT_TABLES_GEN_HOST_H */
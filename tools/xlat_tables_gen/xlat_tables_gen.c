@@ -0,0 +1,436 @@
+/*
+ * Copyright (c) 2020, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Host tool that builds the translation tables of a BL image from the static
+ * memory map provided by the platform, using the xlat_tables_v2 library, and
+ * writes them as a C source file. The source file defines the translation
+ * context of the image, already initialized, so that the image doesn't need to
+ * build its translation tables at runtime before enabling the MMU.
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <platform_def.h>
+
+#include <lib/cassert.h>
+#include <lib/xlat_tables/xlat_tables_v2.h>
+
+#include "xlat_tables_private.h"
+
+#if defined(IMAGE_AT_EL3)
+#define XLAT_GEN_REGIME		EL3_REGIME
+#define XLAT_GEN_REGIME_NAME	"EL3_REGIME"
+#else
+#define XLAT_GEN_REGIME		EL1_EL0_REGIME
+#define XLAT_GEN_REGIME_NAME	"EL1_EL0_REGIME"
+#endif
+
+/* The host pointers to the tables are used as table descriptors addresses. */
+CASSERT(sizeof(uintptr_t) == sizeof(uint64_t), assert_xlat_gen_host_64bit);
+
+/*
+ * Static memory map of the BL image, terminated by an entry with size == 0.
+ * This is the table named by BLx_XLAT_MMAP, defined in the BLx_XLAT_MMAP_SOURCES
+ * files of the platform.
+ */
+#ifndef XLAT_GEN_MMAP
+#error "XLAT_GEN_MMAP must name the memory map of the BL image"
+#endif
+extern const mmap_region_t XLAT_GEN_MMAP[];
+
+REGISTER_XLAT_CONTEXT2(gen, MAX_MMAP_REGIONS, MAX_XLAT_TABLES,
+		       PLAT_VIRT_ADDR_SPACE_SIZE, PLAT_PHY_ADDR_SPACE_SIZE,
+		       XLAT_GEN_REGIME, "xlat_table", "base_xlat_table");
+
+/* Lookup level of each table of the context, 0 if it isn't used. */
+static unsigned int tables_level[MAX_XLAT_TABLES];
+
+static int table_index(const xlat_ctx_t *ctx, uint64_t desc)
+{
+	uintptr_t addr = (uintptr_t)(desc & TABLE_ADDR_MASK);
+	uintptr_t base = (uintptr_t)ctx->tables;
+
+	if ((addr < base) || (addr >= (uintptr_t)&ctx->tables[ctx->tables_num])) {
+		fprintf(stderr, "Invalid table address 0x%lx\n", addr);
+		exit(EXIT_FAILURE);
+	}
+
+	return (int)((addr - base) / XLAT_TABLE_SIZE);
+}
+
+/* Find the lookup level of the tables referenced by the specified table. */
+static void find_tables_level(const xlat_ctx_t *ctx, const uint64_t *table,
+			      unsigned int entries, unsigned int level)
+{
+	if (level == XLAT_TABLE_LEVEL_MAX)
+		return;
+
+	for (unsigned int i = 0U; i < entries; i++) {
+		if ((table[i] & DESC_MASK) != TABLE_DESC)
+			continue;
+
+		int idx = table_index(ctx, table[i]);
+
+		tables_level[idx] = level + 1U;
+		find_tables_level(ctx, ctx->tables[idx], XLAT_TABLE_ENTRIES,
+				  level + 1U);
+	}
+}
+
+/*
+ * Returns the region of the memory map that the translation tables must use to
+ * map the specified VA, or NULL if it isn't in the memory map. When regions
+ * overlap, the innermost one takes precedence.
+ */
+static const mmap_region_t *find_region(const xlat_ctx_t *ctx, uintptr_t va)
+{
+	const mmap_region_t *found = NULL;
+
+	for (const mmap_region_t *mm = ctx->mmap; mm->size != 0U; mm++) {
+		if ((va < mm->base_va) || (va > (mm->base_va + mm->size - 1U)))
+			continue;
+
+		if ((found == NULL) || (mm->size < found->size))
+			found = mm;
+	}
+
+	return found;
+}
+
+static void verify_error(const char *msg, uintptr_t va, unsigned int level)
+{
+	fprintf(stderr, "Invalid translation tables: %s (VA 0x%lx, level %u)\n",
+		msg, va, level);
+	exit(EXIT_FAILURE);
+}
+
+/*
+ * Checks a block or page descriptor against the memory map, which is used as
+ * reference model of the translation tables.
+ */
+static void verify_desc(const xlat_ctx_t *ctx, uintptr_t va, uint64_t desc,
+			unsigned int level)
+{
+	uintptr_t end_va = va + XLAT_BLOCK_SIZE(level) - 1U;
+	const mmap_region_t *mm = find_region(ctx, va);
+	unsigned long long pa;
+
+	if (mm == NULL)
+		verify_error("VA not in the memory map is mapped", va, level);
+
+	if ((end_va > (mm->base_va + mm->size - 1U)) ||
+	    (XLAT_BLOCK_SIZE(level) > mm->granularity))
+		verify_error("descriptor too large for its region", va, level);
+
+	/*
+	 * Any inner region overlapping the descriptor needs finer descriptors,
+	 * unless it is mapped the same way.
+	 */
+	for (const mmap_region_t *in = ctx->mmap; in->size != 0U; in++) {
+		if ((in->size >= mm->size) || (in->base_va > end_va) ||
+		    ((in->base_va + in->size - 1U) < va))
+			continue;
+
+		if ((in->attr != mm->attr) ||
+		    ((in->base_pa - in->base_va) != (mm->base_pa - mm->base_va)))
+			verify_error("inner region not mapped", va, level);
+	}
+
+	pa = mm->base_pa + (va - mm->base_va);
+	if ((pa & XLAT_BLOCK_MASK(level)) != 0U)
+		verify_error("misaligned output address", va, level);
+
+	if ((desc & ~UPPER_ATTRS(CONT_HINT)) != xlat_desc(ctx, mm->attr, pa, level))
+		verify_error("wrong descriptor", va, level);
+}
+
+/* Number of block and page descriptors, and of tables, at each level. */
+static unsigned int desc_count[XLAT_TABLE_LEVEL_MAX + 1U];
+static unsigned int table_count[XLAT_TABLE_LEVEL_MAX + 1U];
+static unsigned long long mapped_size;
+
+static void verify_table(const xlat_ctx_t *ctx, const uint64_t *table,
+			 unsigned int entries, unsigned int level,
+			 uintptr_t table_base_va)
+{
+	table_count[level]++;
+
+	for (unsigned int i = 0U; i < entries; i++) {
+		uintptr_t va = table_base_va + ((uintptr_t)i << XLAT_ADDR_SHIFT(level));
+		uint64_t desc = table[i];
+
+		if ((desc & DESC_MASK) == INVALID_DESC)
+			continue;
+
+		if ((level < XLAT_TABLE_LEVEL_MAX) &&
+		    ((desc & DESC_MASK) == TABLE_DESC)) {
+			verify_table(ctx, ctx->tables[table_index(ctx, desc)],
+				     XLAT_TABLE_ENTRIES, level + 1U, va);
+			continue;
+		}
+
+		if ((level < MIN_LVL_BLOCK_DESC) ||
+		    ((level < XLAT_TABLE_LEVEL_MAX) &&
+		     ((desc & DESC_MASK) != BLOCK_DESC)))
+			verify_error("invalid descriptor type", va, level);
+
+		/* All the descriptors of a contiguous group must have the hint */
+		if (((desc & UPPER_ATTRS(CONT_HINT)) != 0U) &&
+		    ((i % XLAT_CONTIG_ENTRIES) == 0U)) {
+			for (unsigned int j = 1U; j < XLAT_CONTIG_ENTRIES; j++) {
+				if ((table[i + j] & UPPER_ATTRS(CONT_HINT)) == 0U)
+					verify_error("incomplete contiguous group",
+						     va, level);
+			}
+		}
+
+		verify_desc(ctx, va, desc, level);
+		desc_count[level]++;
+		mapped_size += XLAT_BLOCK_SIZE(level);
+	}
+}
+
+/*
+ * Checks that the translation tables map exactly the memory map of the context,
+ * with the attributes of the innermost region for each address.
+ */
+static void verify_tables(const xlat_ctx_t *ctx)
+{
+	unsigned long long map_size = 0ULL;
+
+	verify_table(ctx, ctx->base_table, ctx->base_table_entries,
+		     ctx->base_level, 0U);
+
+	/*
+	 * Each mapped address is in a region, so the mapped size must be the one
+	 * of the outermost regions for all of them to be mapped.
+	 */
+	for (const mmap_region_t *mm = ctx->mmap; mm->size != 0U; mm++) {
+		bool inner = false;
+
+		for (const mmap_region_t *o = ctx->mmap; o->size != 0U; o++) {
+			if ((o == mm) || (o->base_va > mm->base_va) ||
+			    ((o->base_va + o->size) < (mm->base_va + mm->size)))
+				continue;
+
+			/* Identical regions are only accounted for once */
+			if ((o->size > mm->size) || (o < mm))
+				inner = true;
+		}
+
+		if (!inner)
+			map_size += mm->size;
+	}
+
+	if (mapped_size != map_size) {
+		fprintf(stderr, "Invalid translation tables: 0x%llx bytes mapped "
+			"instead of 0x%llx\n", mapped_size, map_size);
+		exit(EXIT_FAILURE);
+	}
+}
+
+static void print_stats(const xlat_ctx_t *ctx, double init_us)
+{
+	unsigned int used = 0U;
+
+	/* The base table isn't one of the tables of the context */
+	for (unsigned int level = ctx->base_level;
+	     level <= XLAT_TABLE_LEVEL_MAX; level++)
+		used += table_count[level];
+
+	printf("Translation tables: %u/%d tables used, initialized in %.1f us\n",
+	       used - 1U, ctx->tables_num, init_us);
+
+	for (unsigned int level = ctx->base_level;
+	     level <= XLAT_TABLE_LEVEL_MAX; level++) {
+		printf("  Level %u: %u tables, %u block/page descriptors\n",
+		       level, table_count[level], desc_count[level]);
+	}
+}
+
+static void write_table(FILE *out, const xlat_ctx_t *ctx,
+			const uint64_t *table, unsigned int entries,
+			unsigned int level, const char *indent)
+{
+	for (unsigned int i = 0U; i < entries; i++) {
+		uint64_t desc = table[i];
+
+		if ((desc & DESC_MASK) == INVALID_DESC)
+			continue;
+
+		if ((level < XLAT_TABLE_LEVEL_MAX) &&
+		    ((desc & DESC_MASK) == TABLE_DESC)) {
+			fprintf(out, "%s[%u] = XLAT_PREBUILT_TABLE_DESC(%d),\n",
+				indent, i, table_index(ctx, desc));
+		} else {
+			fprintf(out, "%s[%u] = 0x%016llxULL,\n", indent, i,
+				(unsigned long long)desc);
+		}
+	}
+}
+
+static void write_context(FILE *out, const xlat_ctx_t *ctx)
+{
+	const mmap_region_t *mm;
+	int used_tables = 0;
+
+	for (int i = 0; i < ctx->tables_num; i++) {
+		if (tables_level[i] != 0U)
+			used_tables = i + 1;
+	}
+
+	fprintf(out,
+		"/*\n"
+		" * Translation context of the BL image, generated at build time by\n"
+		" * xlat_tables_gen. Do not edit.\n"
+		" */\n\n"
+		"#include <stdbool.h>\n"
+		"#include <stdint.h>\n\n"
+		"#include <platform_def.h>\n\n"
+		"#include <lib/cassert.h>\n"
+		"#include <lib/xlat_tables/xlat_tables_v2.h>\n\n"
+		"CASSERT((MAX_MMAP_REGIONS == %d) && (MAX_XLAT_TABLES == %d),\n"
+		"\tassert_xlat_prebuilt_tables_out_of_date);\n\n",
+		ctx->mmap_num, ctx->tables_num);
+
+	fprintf(out, "static mmap_region_t tf_mmap[MAX_MMAP_REGIONS + 1] = {\n");
+	for (mm = ctx->mmap; mm->size != 0U; mm++) {
+		fprintf(out, "\tMAP_REGION2(0x%llxULL, 0x%lxUL, 0x%zxUL, 0x%xU,"
+			" 0x%zxUL),\n", mm->base_pa, mm->base_va, mm->size,
+			mm->attr, mm->granularity);
+	}
+	fprintf(out, "};\n\n");
+
+	fprintf(out,
+		"#define XLAT_PREBUILT_TABLE_DESC(_idx)\t\t\t\t\t\\\n"
+		"\t((uint64_t)(uintptr_t)tf_xlat_tables[_idx] + TABLE_DESC)\n\n"
+		"static uint64_t tf_xlat_tables[MAX_XLAT_TABLES][XLAT_TABLE_ENTRIES]\n"
+		"\t__aligned(XLAT_TABLE_SIZE) = {\n");
+	for (int i = 0; i < used_tables; i++) {
+		if (tables_level[i] == 0U)
+			continue;
+
+		fprintf(out, "\t/* Level %u */\n\t[%d] = {\n",
+			tables_level[i], i);
+		write_table(out, ctx, ctx->tables[i], XLAT_TABLE_ENTRIES,
+			    tables_level[i], "\t\t");
+		fprintf(out, "\t},\n");
+	}
+	fprintf(out, "};\n\n");
+
+	fprintf(out,
+		"static uint64_t tf_base_xlat_table\n"
+		"\t[GET_NUM_BASE_LEVEL_ENTRIES(PLAT_VIRT_ADDR_SPACE_SIZE)]\n"
+		"\t__aligned(GET_NUM_BASE_LEVEL_ENTRIES(PLAT_VIRT_ADDR_SPACE_SIZE)\n"
+		"\t\t* sizeof(uint64_t)) = {\n");
+	write_table(out, ctx, ctx->base_table, ctx->base_table_entries,
+		    ctx->base_level, "\t");
+	fprintf(out, "};\n\n");
+
+#if PLAT_XLAT_TABLES_DYNAMIC
+	fprintf(out, "static int tf_mapped_regions[MAX_XLAT_TABLES] = {\n");
+	for (int i = 0; i < ctx->tables_num; i++) {
+		if (ctx->tables_mapped_regions[i] != 0) {
+			fprintf(out, "\t[%d] = %d,\n", i,
+				ctx->tables_mapped_regions[i]);
+		}
+	}
+	fprintf(out, "};\n\n");
+
+	fprintf(out, "static int tf_free_tables[MAX_XLAT_TABLES] = {\n");
+	for (int i = 0; i < ctx->tables_free_num; i++)
+		fprintf(out, "\t%d,\n", ctx->tables_free[i]);
+	fprintf(out, "};\n\n");
+#endif
+
+	fprintf(out,
+		"xlat_ctx_t tf_xlat_ctx = {\n"
+		"\t.pa_max_address = PLAT_PHY_ADDR_SPACE_SIZE - 1ULL,\n"
+		"\t.va_max_address = PLAT_VIRT_ADDR_SPACE_SIZE - 1UL,\n"
+		"\t.mmap = tf_mmap,\n"
+		"\t.mmap_num = MAX_MMAP_REGIONS,\n"
+		"\t.tables = tf_xlat_tables,\n"
+		"\t.tables_num = MAX_XLAT_TABLES,\n"
+		"\t.readonly_tables = false,\n");
+#if PLAT_XLAT_TABLES_DYNAMIC
+	fprintf(out,
+		"\t.tables_mapped_regions = tf_mapped_regions,\n"
+		"\t.tables_free = tf_free_tables,\n"
+		"\t.tables_free_num = %d,\n", ctx->tables_free_num);
+#endif
+	fprintf(out,
+		"\t.next_table = %d,\n"
+		"\t.base_table = tf_base_xlat_table,\n"
+		"\t.base_table_entries =\n"
+		"\t\tGET_NUM_BASE_LEVEL_ENTRIES(PLAT_VIRT_ADDR_SPACE_SIZE),\n"
+		"\t.max_pa = 0x%llxULL,\n"
+		"\t.max_va = 0x%lxUL,\n"
+		"\t.base_level = GET_XLAT_TABLE_LEVEL_BASE(PLAT_VIRT_ADDR_SPACE_SIZE),\n"
+		"\t.initialized = true,\n"
+		"\t.xlat_regime = %s,\n"
+		"};\n",
+		ctx->next_table, ctx->max_pa, ctx->max_va,
+		XLAT_GEN_REGIME_NAME);
+}
+
+int main(int argc, char *argv[])
+{
+	struct timespec start, end;
+	bool verbose = false;
+	FILE *out;
+
+	if ((argc == 3) && (strcmp(argv[1], "-v") == 0)) {
+		verbose = true;
+		argv++;
+		argc--;
+	}
+
+	if (argc != 2) {
+		fprintf(stderr, "Usage: %s [-v] <output C file>\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &start);
+	mmap_add_ctx(&gen_xlat_ctx, XLAT_GEN_MMAP);
+	init_xlat_tables_ctx(&gen_xlat_ctx);
+	(void)clock_gettime(CLOCK_MONOTONIC, &end);
+
+	verify_tables(&gen_xlat_ctx);
+
+	if (verbose) {
+		print_stats(&gen_xlat_ctx,
+			    ((end.tv_sec - start.tv_sec) * 1e6) +
+			    ((end.tv_nsec - start.tv_nsec) / 1e3));
+	}
+
+	find_tables_level(&gen_xlat_ctx, gen_xlat_ctx.base_table,
+			  gen_xlat_ctx.base_table_entries,
+			  gen_xlat_ctx.base_level);
+
+	out = fopen(argv[1], "w");
+	if (out == NULL) {
+		fprintf(stderr, "Failed to open %s: %s\n", argv[1],
+			strerror(errno));
+		return EXIT_FAILURE;
+	}
+
+	write_context(out, &gen_xlat_ctx);
+
+	if (fclose(out) != 0) {
+		fprintf(stderr, "Failed to write %s: %s\n", argv[1],
+			strerror(errno));
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2020, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Host implementation of the architectural module of the xlat_tables_v2
+ * library, and of the few other firmware services that the library needs.
+ */
+
+#include <assert.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <drivers/console.h>
+#include <lib/xlat_tables/xlat_tables_v2.h>
+
+#include "xlat_tables_private.h"
+
+void tf_log(const char *fmt, ...)
+{
+	va_list args;
+
+	/* Skip the log level marker */
+	assert(fmt[0] != '\0');
+	fmt++;
+
+	va_start(args, fmt);
+	(void)vprintf(fmt, args);
+	va_end(args);
+}
+
+int console_flush(void)
+{
+	return fflush(stdout);
+}
+
+void do_panic(void)
+{
+	exit(EXIT_FAILURE);
+}
+
+void flush_dcache_range(uintptr_t addr, size_t size)
+{
+}
+
+void clean_dcache_range(uintptr_t addr, size_t size)
+{
+}
+
+void inv_dcache_range(uintptr_t addr, size_t size)
+{
+}
+
+uint64_t xlat_arch_regime_get_xn_desc(int xlat_regime)
+{
+	if (xlat_regime == EL1_EL0_REGIME) {
+		return UPPER_ATTRS(UXN) | UPPER_ATTRS(PXN);
+	} else {
+		assert((xlat_regime == EL2_REGIME) ||
+		       (xlat_regime == EL3_REGIME));
+		return UPPER_ATTRS(XN);
+	}
+}
+
+/*
+ * There is no TLB on the host, but the preconditions of the target
+ * implementations are checked so that the host tests catch invalid ranges.
+ */
+void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
+{
+	assert((va & PAGE_SIZE_MASK) == 0U);
+}
+
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime)
+{
+	assert((va & PAGE_SIZE_MASK) == 0U);
+	assert((size % PAGE_SIZE) == 0U);
+}
+
+void xlat_arch_tlbi_va_sync(void)
+{
+}
+
+unsigned int xlat_arch_current_el(void)
+{
+#if defined(IMAGE_AT_EL3)
+	return 3U;
+#else
+	return 1U;
+#endif
+}
+
+/*
+ * The physical address range of the CPU is only known at runtime, where it is
+ * checked against the one of the generated translation context.
+ */
+unsigned long long xlat_arch_get_max_supported_pa(void)
+{
+	return PLAT_PHY_ADDR_SPACE_SIZE - 1ULL;
+}
+
+uintptr_t xlat_get_min_virt_addr_space_size(void)
+{
+	return MIN_VIRT_ADDR_SPACE_SIZE;
+}
+
+bool is_mmu_enabled_ctx(const xlat_ctx_t *ctx)
+{
+	return false;
+}
+
+bool is_dcache_enabled(void)
+{
+	return false;
+}
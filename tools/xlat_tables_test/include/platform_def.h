@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2020, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Platform definitions used to build the xlat_tables_v2 library for the host
+ * tests. Each test registers its own translation contexts, so only the
+ * definitions needed by the library itself are provided.
+ */
+
+#ifndef PLATFORM_DEF_H
+#define PLATFORM_DEF_H
+
+#define PLAT_VIRT_ADDR_SPACE_SIZE	(1ULL << 32)
+#define PLAT_PHY_ADDR_SPACE_SIZE	(1ULL << 32)
+
+#define MAX_MMAP_REGIONS		64
+#define MAX_XLAT_TABLES			64
+
+#define CACHE_WRITEBACK_GRANULE		64
+
+#endif /* PLATFORM_DEF_H */
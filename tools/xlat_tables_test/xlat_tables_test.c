@@ -0,0 +1,961 @@
+/*
+ * Copyright (c) 2020, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Host tests of the xlat_tables_v2 library. The translation tables are built
+ * in host memory and inspected directly after each operation.
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <platform_def.h>
+
+#include <lib/cassert.h>
+#include <lib/xlat_tables/xlat_tables_v2.h>
+
+#include "xlat_tables_private.h"
+
+/* The host pointers to the tables are used as table descriptors addresses. */
+CASSERT(sizeof(uintptr_t) == sizeof(uint64_t), assert_xlat_test_host_64bit);
+
+#define TEST_BASE_VA		UL(0x80000000)
+#define TEST_BASE_PA		ULL(0x80000000)
+
+static unsigned int test_failures;
+
+#define CHECK(cond)							\
+	do {								\
+		if (!(cond)) {						\
+			fprintf(stderr, "%s:%d: check failed: %s\n",	\
+				__FILE__, __LINE__, #cond);		\
+			test_failures++;				\
+		}							\
+	} while (false)
+
+/*
+ * Check the contiguous hint of the descriptors of the specified table and of
+ * its subtables: the hint must be set in all the descriptors of an aligned
+ * group or in none, and a hinted group must map consecutive output addresses
+ * with the same attributes.
+ */
+static void check_contig_hints(const uint64_t *table, unsigned int entries,
+			       unsigned int level)
+{
+	uint64_t attr_mask = ~(TABLE_ADDR_MASK | UPPER_ATTRS(CONT_HINT));
+
+	for (unsigned int i = 0U; i < entries; i++) {
+		uint64_t desc = table[i];
+
+		if ((level < XLAT_TABLE_LEVEL_MAX) &&
+		    ((desc & DESC_MASK) == TABLE_DESC)) {
+			check_contig_hints((const uint64_t *)(uintptr_t)
+					   (desc & TABLE_ADDR_MASK),
+					   XLAT_TABLE_ENTRIES, level + 1U);
+			continue;
+		}
+
+		if (((i % XLAT_CONTIG_ENTRIES) != 0U) ||
+		    ((desc & UPPER_ATTRS(CONT_HINT)) == 0ULL))
+			continue;
+
+		uint64_t pa = desc & TABLE_ADDR_MASK;
+
+		CHECK((pa & (XLAT_CONTIG_SIZE(level) - 1U)) == 0U);
+		CHECK((i + XLAT_CONTIG_ENTRIES) <= entries);
+
+		for (unsigned int j = 1U; (j < XLAT_CONTIG_ENTRIES) &&
+					  ((i + j) < entries); j++) {
+			uint64_t next = table[i + j];
+
+			CHECK((next & UPPER_ATTRS(CONT_HINT)) != 0ULL);
+			CHECK((next & attr_mask) == (desc & attr_mask));
+			CHECK((next & TABLE_ADDR_MASK) ==
+			      (pa + (j * XLAT_BLOCK_SIZE(level))));
+		}
+	}
+
+	for (unsigned int i = 0U; i < entries; i++) {
+		if (((i % XLAT_CONTIG_ENTRIES) != 0U) &&
+		    ((table[i] & UPPER_ATTRS(CONT_HINT)) != 0ULL))
+			CHECK((table[round_down(i, XLAT_CONTIG_ENTRIES)] &
+			       UPPER_ATTRS(CONT_HINT)) != 0ULL);
+	}
+}
+
+/* Number of page descriptors of the context that use the contiguous hint. */
+static unsigned int count_contig_pages(const xlat_ctx_t *ctx)
+{
+	unsigned int count = 0U;
+
+	for (int i = 0; i < ctx->tables_num; i++) {
+		if (ctx->tables_mapped_regions[i] == 0)
+			continue;
+
+		for (unsigned int j = 0U; j < XLAT_TABLE_ENTRIES; j++) {
+			uint64_t desc = ctx->tables[i][j];
+
+			if (((desc & DESC_MASK) == PAGE_DESC) &&
+			    ((desc & UPPER_ATTRS(CONT_HINT)) != 0ULL))
+				count++;
+		}
+	}
+
+	return count;
+}
+
+/* Deterministic pseudo-random number generator used by the tests. */
+static uint64_t test_rand_state = 0x9e3779b97f4a7c15ULL;
+
+static uint64_t test_rand(void)
+{
+	test_rand_state ^= test_rand_state << 13;
+	test_rand_state ^= test_rand_state >> 7;
+	test_rand_state ^= test_rand_state << 17;
+
+	return test_rand_state;
+}
+
+static unsigned int test_rand_range(unsigned int max)
+{
+	return (unsigned int)(test_rand() % max);
+}
+
+/*
+ * Walk the tables of the context and count the table descriptors that point to
+ * each subtable.
+ */
+static void count_table_refs(const xlat_ctx_t *ctx, const uint64_t *table,
+			     unsigned int entries, unsigned int level,
+			     unsigned int *refs)
+{
+	if (level == XLAT_TABLE_LEVEL_MAX)
+		return;
+
+	for (unsigned int i = 0U; i < entries; i++) {
+		if ((table[i] & DESC_MASK) != TABLE_DESC)
+			continue;
+
+		uintptr_t addr = (uintptr_t)(table[i] & TABLE_ADDR_MASK);
+		uintptr_t base = (uintptr_t)ctx->tables;
+
+		CHECK((addr >= base) &&
+		      (addr < (uintptr_t)&ctx->tables[ctx->tables_num]));
+
+		unsigned int idx = (unsigned int)((addr - base) /
+						  XLAT_TABLE_SIZE);
+
+		refs[idx]++;
+		count_table_refs(ctx, ctx->tables[idx], XLAT_TABLE_ENTRIES,
+				 level + 1U, refs);
+	}
+}
+
+/*
+ * Check the accounting of the subtables of a context: a table is referenced by
+ * exactly one table descriptor if and only if it has regions mapped, and the
+ * other tables are invalid and all in the stack of free tables.
+ */
+static void check_tables_accounting(const xlat_ctx_t *ctx)
+{
+	unsigned int refs[MAX_XLAT_TABLES] = { 0U };
+	bool is_free[MAX_XLAT_TABLES] = { false };
+	int free_num = 0;
+
+	CHECK(ctx->tables_num <= MAX_XLAT_TABLES);
+
+	count_table_refs(ctx, ctx->base_table, ctx->base_table_entries,
+			 ctx->base_level, refs);
+
+	for (int i = 0; i < ctx->tables_free_num; i++) {
+		int idx = ctx->tables_free[i];
+
+		CHECK((idx >= 0) && (idx < ctx->tables_num));
+		CHECK(!is_free[idx]);
+		is_free[idx] = true;
+	}
+
+	for (int i = 0; i < ctx->tables_num; i++) {
+		if (ctx->tables_mapped_regions[i] != 0) {
+			CHECK(refs[i] == 1U);
+			CHECK(!is_free[i]);
+			continue;
+		}
+
+		CHECK(refs[i] == 0U);
+		CHECK(is_free[i]);
+		free_num++;
+
+		for (unsigned int j = 0U; j < XLAT_TABLE_ENTRIES; j++)
+			CHECK((ctx->tables[i][j] & DESC_MASK) == INVALID_DESC);
+	}
+
+	CHECK(free_num == ctx->tables_free_num);
+}
+
+REGISTER_XLAT_CONTEXT2(attr, MAX_MMAP_REGIONS, MAX_XLAT_TABLES,
+		       PLAT_VIRT_ADDR_SPACE_SIZE, PLAT_PHY_ADDR_SPACE_SIZE,
+		       EL3_REGIME, "xlat_table", "base_xlat_table");
+
+/*
+ * Change the attributes of a range of pages that starts and ends in the middle
+ * of groups of contiguous descriptors, then restore them.
+ */
+static void test_change_attributes(void)
+{
+	xlat_ctx_t *ctx = &attr_xlat_ctx;
+	size_t region_size = 2U * 1024U * 1024U;
+	size_t pages = region_size / PAGE_SIZE;
+	uintptr_t change_va = TEST_BASE_VA + (3U * PAGE_SIZE);
+	size_t change_size = 37U * PAGE_SIZE;
+	mmap_region_t mm = MAP_REGION2(TEST_BASE_PA, TEST_BASE_VA, region_size,
+				       MT_MEMORY | MT_RW | MT_SECURE,
+				       PAGE_SIZE);
+	uint32_t initial_attr, attr;
+
+	mmap_add_region_ctx(ctx, &mm);
+	init_xlat_tables_ctx(ctx);
+
+	CHECK(count_contig_pages(ctx) == pages);
+	CHECK(xlat_get_mem_attributes_ctx(ctx, TEST_BASE_VA,
+					  &initial_attr) == 0);
+
+	CHECK(xlat_change_mem_attributes_ctx(ctx, change_va, change_size,
+					     MT_RO | MT_EXECUTE_NEVER) == 0);
+
+	for (size_t i = 0U; i < pages; i++) {
+		uintptr_t va = TEST_BASE_VA + (i * PAGE_SIZE);
+		bool changed = (va >= change_va) &&
+			       (va < (change_va + change_size));
+
+		CHECK(xlat_get_mem_attributes_ctx(ctx, va, &attr) == 0);
+		CHECK(attr == (changed ?
+			       ((initial_attr & ~MT_RW) | MT_EXECUTE_NEVER) :
+			       initial_attr));
+	}
+
+	check_contig_hints(ctx->base_table, ctx->base_table_entries,
+			   ctx->base_level);
+	/*
+	 * The two groups partially covered by the range lose their hint, the
+	 * one fully covered keeps it.
+	 */
+	CHECK(count_contig_pages(ctx) ==
+	      (pages - (2U * XLAT_CONTIG_ENTRIES)));
+
+	CHECK(xlat_change_mem_attributes_ctx(ctx, change_va, change_size,
+					     MT_RW | MT_EXECUTE_NEVER) == 0);
+
+	for (size_t i = 0U; i < pages; i++) {
+		CHECK(xlat_get_mem_attributes_ctx(ctx,
+			TEST_BASE_VA + (i * PAGE_SIZE), &attr) == 0);
+		CHECK(attr == initial_attr);
+	}
+
+	/*
+	 * The hint is only set again in the groups fully covered by a change,
+	 * the pages outside of the range aren't rewritten.
+	 */
+	check_contig_hints(ctx->base_table, ctx->base_table_entries,
+			   ctx->base_level);
+	CHECK(count_contig_pages(ctx) ==
+	      (pages - (2U * XLAT_CONTIG_ENTRIES)));
+
+	CHECK(xlat_change_mem_attributes_ctx(ctx, TEST_BASE_VA, region_size,
+					     MT_RW | MT_EXECUTE_NEVER) == 0);
+	check_contig_hints(ctx->base_table, ctx->base_table_entries,
+			   ctx->base_level);
+	CHECK(count_contig_pages(ctx) == pages);
+
+	/* Invalid requests don't modify the tables. */
+	CHECK(xlat_change_mem_attributes_ctx(ctx, change_va, change_size,
+					     MT_RW | MT_EXECUTE) == -EINVAL);
+	CHECK(xlat_change_mem_attributes_ctx(ctx, TEST_BASE_VA + region_size,
+					     PAGE_SIZE, MT_RO) == -EINVAL);
+	CHECK(xlat_change_mem_attributes_ctx(ctx, change_va + 1U, PAGE_SIZE,
+					     MT_RO) == -EINVAL);
+	CHECK(count_contig_pages(ctx) == pages);
+}
+
+#define STRESS_XLAT_TABLES	U(24)
+#define STRESS_SLOTS		U(64)
+#define STRESS_SLOT_SIZE	UL(0x400000)
+#define STRESS_BASE_VA		UL(0xC0000000)
+#define STRESS_MAX_REGIONS	U(32)
+#define STRESS_ITERATIONS	U(20000)
+
+/* Few tables are given to the context so that some regions can't be mapped */
+REGISTER_XLAT_CONTEXT2(stress, MAX_MMAP_REGIONS, STRESS_XLAT_TABLES,
+		       PLAT_VIRT_ADDR_SPACE_SIZE, PLAT_PHY_ADDR_SPACE_SIZE,
+		       EL3_REGIME, "xlat_table", "base_xlat_table");
+
+/*
+ * Add and remove thousands of dynamic regions of random sizes and
+ * granularities, and check that the translation tables used by each region
+ * are returned to the stack of free tables when it is removed.
+ */
+static void test_dynamic_stress(void)
+{
+	xlat_ctx_t *ctx = &stress_xlat_ctx;
+	mmap_region_t slots[STRESS_SLOTS] = { { 0 } };
+	mmap_region_t mm = MAP_REGION2(TEST_BASE_PA, TEST_BASE_VA,
+				       16U * PAGE_SIZE,
+				       MT_MEMORY | MT_RW | MT_SECURE,
+				       PAGE_SIZE);
+	static uint64_t base_table[GET_NUM_BASE_LEVEL_ENTRIES(
+					   PLAT_VIRT_ADDR_SPACE_SIZE)];
+	unsigned int live = 0U;
+	unsigned int added = 0U, failed = 0U;
+	int free_num;
+
+	mmap_add_region_ctx(ctx, &mm);
+	init_xlat_tables_ctx(ctx);
+
+	memcpy(base_table, ctx->base_table, sizeof(base_table));
+	free_num = ctx->tables_free_num;
+	check_tables_accounting(ctx);
+
+	for (unsigned int i = 0U; i < STRESS_ITERATIONS; i++) {
+		unsigned int slot = test_rand_range(STRESS_SLOTS);
+		mmap_region_t *r = &slots[slot];
+
+		if (r->size != 0U) {
+			CHECK(mmap_remove_dynamic_region_ctx(ctx, r->base_va,
+							     r->size) == 0);
+			r->size = 0U;
+			live--;
+		} else if (live < STRESS_MAX_REGIONS) {
+			size_t offset = test_rand_range(
+				STRESS_SLOT_SIZE / PAGE_SIZE) * PAGE_SIZE;
+			size_t size = (test_rand_range(
+				(STRESS_SLOT_SIZE - offset) / PAGE_SIZE) + 1U) *
+				PAGE_SIZE;
+			uintptr_t va = STRESS_BASE_VA +
+				       (slot * STRESS_SLOT_SIZE) + offset;
+
+			*r = (mmap_region_t)MAP_REGION2(va, va, size,
+				MT_MEMORY | MT_RW | MT_NS,
+				(test_rand_range(2U) == 0U) ?
+				PAGE_SIZE : XLAT_BLOCK_SIZE(2U));
+
+			int ret = mmap_add_dynamic_region_ctx(ctx, r);
+
+			if (ret == 0) {
+				live++;
+				added++;
+			} else {
+				/* Running out of tables is the only error */
+				CHECK(ret == -ENOMEM);
+				r->size = 0U;
+				failed++;
+			}
+		}
+
+		/* The static region and the live ones are in the mmap array */
+		CHECK(ctx->mmap[live].size != 0U);
+		CHECK(ctx->mmap[live + 1U].size == 0U);
+
+		if ((i % 256U) == 0U)
+			check_tables_accounting(ctx);
+	}
+
+	check_tables_accounting(ctx);
+
+	for (unsigned int i = 0U; i < STRESS_SLOTS; i++) {
+		if (slots[i].size == 0U)
+			continue;
+
+		CHECK(mmap_remove_dynamic_region_ctx(ctx, slots[i].base_va,
+						     slots[i].size) == 0);
+	}
+
+	/* All the tables of the dynamic regions have been reclaimed. */
+	check_tables_accounting(ctx);
+	CHECK(ctx->tables_free_num == free_num);
+	CHECK(memcmp(base_table, ctx->base_table, sizeof(base_table)) == 0);
+	CHECK(ctx->mmap[1].size == 0U);
+	CHECK(ctx->max_va == (TEST_BASE_VA + (16U * PAGE_SIZE) - 1U));
+	CHECK(added > (STRESS_ITERATIONS / 8U));
+
+	printf("  %u regions added, %u failed for lack of tables\n", added,
+	       failed);
+}
+
+#define EXHAUST_XLAT_TABLES	U(4)
+#define EXHAUST_BASE_VA		UL(0xC0000000)
+
+/*
+ * The static region uses a level 2 and a level 3 table, so only two tables are
+ * left for the dynamic regions.
+ */
+REGISTER_XLAT_CONTEXT2(exhaust, MAX_MMAP_REGIONS, EXHAUST_XLAT_TABLES,
+		       PLAT_VIRT_ADDR_SPACE_SIZE, PLAT_PHY_ADDR_SPACE_SIZE,
+		       EL3_REGIME, "xlat_table", "base_xlat_table");
+
+/*
+ * Run out of tables in the middle of adding a dynamic region, once part of it
+ * has been mapped, and check that the partial mapping is undone and its tables
+ * are reclaimed.
+ */
+static void test_dynamic_exhaust(void)
+{
+	xlat_ctx_t *ctx = &exhaust_xlat_ctx;
+	mmap_region_t mm = MAP_REGION2(TEST_BASE_PA, TEST_BASE_VA,
+				       16U * PAGE_SIZE,
+				       MT_MEMORY | MT_RW | MT_SECURE,
+				       PAGE_SIZE);
+	/*
+	 * Starts in the middle of a page table and needs a level 2 table and
+	 * three level 3 tables: the first 2MB are mapped before the add fails.
+	 */
+	mmap_region_t big = MAP_REGION2(EXHAUST_BASE_VA + (3U * PAGE_SIZE),
+					EXHAUST_BASE_VA + (3U * PAGE_SIZE),
+					3U * XLAT_BLOCK_SIZE(2U),
+					MT_MEMORY | MT_RW | MT_NS, PAGE_SIZE);
+	mmap_region_t small = MAP_REGION2(EXHAUST_BASE_VA, EXHAUST_BASE_VA,
+					  PAGE_SIZE, MT_MEMORY | MT_RW | MT_NS,
+					  PAGE_SIZE);
+	static uint64_t base_table[GET_NUM_BASE_LEVEL_ENTRIES(
+					   PLAT_VIRT_ADDR_SPACE_SIZE)];
+	int free_num;
+
+	mmap_add_region_ctx(ctx, &mm);
+	init_xlat_tables_ctx(ctx);
+
+	memcpy(base_table, ctx->base_table, sizeof(base_table));
+	free_num = ctx->tables_free_num;
+	CHECK(free_num == 2);
+	check_tables_accounting(ctx);
+
+	for (unsigned int i = 0U; i < 2U; i++) {
+		CHECK(mmap_add_dynamic_region_ctx(ctx, &big) == -ENOMEM);
+
+		check_tables_accounting(ctx);
+		CHECK(ctx->tables_free_num == free_num);
+		CHECK(memcmp(base_table, ctx->base_table,
+			     sizeof(base_table)) == 0);
+		CHECK(ctx->mmap[1].size == 0U);
+		CHECK(ctx->max_va == (TEST_BASE_VA + (16U * PAGE_SIZE) - 1U));
+	}
+
+	/* The reclaimed tables can be used by a region that fits */
+	CHECK(mmap_add_dynamic_region_ctx(ctx, &small) == 0);
+	check_tables_accounting(ctx);
+	CHECK(ctx->tables_free_num == 0);
+
+	CHECK(mmap_remove_dynamic_region_ctx(ctx, small.base_va,
+					     small.size) == 0);
+	check_tables_accounting(ctx);
+	CHECK(ctx->tables_free_num == free_num);
+	CHECK(memcmp(base_table, ctx->base_table, sizeof(base_table)) == 0);
+}
+
+REGISTER_XLAT_CONTEXT2(fuzz, MAX_MMAP_REGIONS, MAX_XLAT_TABLES,
+		       PLAT_VIRT_ADDR_SPACE_SIZE, PLAT_PHY_ADDR_SPACE_SIZE,
+		       EL3_REGIME, "xlat_table", "base_xlat_table");
+
+/*
+ * The fuzzed window of the virtual address space crosses a 1GB boundary, so
+ * that regions can use two level 2 tables. There are always enough tables for
+ * all the regions that can be live at the same time.
+ */
+#define FUZZ_BASE_VA		UL(0x7F000000)
+#define FUZZ_SIZE		UL(0x2000000)
+#define FUZZ_PAGES		(FUZZ_SIZE / PAGE_SIZE)
+#define FUZZ_PA_BASE		ULL(0xC0000000)
+#define FUZZ_MAX_REGIONS	U(24)
+#define FUZZ_ITERATIONS		U(3000)
+
+CASSERT(FUZZ_MAX_REGIONS < MAX_MMAP_REGIONS, assert_fuzz_max_regions);
+CASSERT(((FUZZ_SIZE / XLAT_BLOCK_SIZE(2U)) + 2U) <= MAX_XLAT_TABLES,
+	assert_fuzz_max_tables);
+
+/* Reference model of the fuzzed window: the live regions and each page. */
+static struct {
+	mmap_region_t mm;
+	bool is_static;
+} fuzz_regions[FUZZ_MAX_REGIONS];
+static unsigned int fuzz_regions_num;
+
+static struct {
+	int region;	/* Index in fuzz_regions[], -1 if not mapped */
+	uint32_t attr;
+} fuzz_pages[FUZZ_PAGES];
+
+/* Timing of each type of operation. */
+enum fuzz_op {
+	FUZZ_OP_ADD,
+	FUZZ_OP_REMOVE,
+	FUZZ_OP_CHANGE,
+	FUZZ_OP_LOOKUP,
+	FUZZ_OP_NUM
+};
+
+static const char *const fuzz_op_names[FUZZ_OP_NUM] = {
+	[FUZZ_OP_ADD] = "add region",
+	[FUZZ_OP_REMOVE] = "remove region",
+	[FUZZ_OP_CHANGE] = "change attributes",
+	[FUZZ_OP_LOOKUP] = "get attributes",
+};
+
+static struct {
+	unsigned long count;
+	unsigned long errors;
+	uint64_t total_ns;
+	uint64_t max_ns;
+} fuzz_op_stats[FUZZ_OP_NUM];
+
+static uint64_t fuzz_now_ns(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static void fuzz_op_account(enum fuzz_op op, uint64_t start, int ret)
+{
+	uint64_t ns = fuzz_now_ns() - start;
+
+	fuzz_op_stats[op].count++;
+	if (ret != 0)
+		fuzz_op_stats[op].errors++;
+	fuzz_op_stats[op].total_ns += ns;
+	if (ns > fuzz_op_stats[op].max_ns)
+		fuzz_op_stats[op].max_ns = ns;
+}
+
+static bool fuzz_ranges_overlap(unsigned long long base1, size_t size1,
+				unsigned long long base2, size_t size2)
+{
+	return (base1 < (base2 + size2)) && (base2 < (base1 + size1));
+}
+
+static unsigned int fuzz_page_idx(uintptr_t va)
+{
+	return (unsigned int)((va - FUZZ_BASE_VA) / PAGE_SIZE);
+}
+
+/*
+ * A 2MB block of the window is mapped with a single block descriptor if a
+ * region covers all of it with a large enough granularity and an aligned
+ * output address. Otherwise, it needs a level 3 table if any of its pages is
+ * mapped.
+ */
+static bool fuzz_block_mapped(unsigned int block)
+{
+	unsigned int first = block * XLAT_TABLE_ENTRIES;
+	int r = fuzz_pages[first].region;
+
+	if (r < 0)
+		return false;
+
+	const mmap_region_t *mm = &fuzz_regions[r].mm;
+	uintptr_t va = FUZZ_BASE_VA + (first * PAGE_SIZE);
+
+	return (mm->granularity >= XLAT_BLOCK_SIZE(2U)) &&
+	       (mm->base_va <= va) &&
+	       ((mm->base_va + mm->size) >= (va + XLAT_BLOCK_SIZE(2U))) &&
+	       (((mm->base_pa + (va - mm->base_va)) &
+		 (XLAT_BLOCK_SIZE(2U) - 1U)) == 0U);
+}
+
+static unsigned int fuzz_expected_tables(void)
+{
+	unsigned int tables = 0U;
+	bool l2_used[2] = { false, false };
+
+	for (unsigned int b = 0U; b < (FUZZ_PAGES / XLAT_TABLE_ENTRIES); b++) {
+		bool used = false;
+
+		for (unsigned int i = 0U; i < XLAT_TABLE_ENTRIES; i++) {
+			if (fuzz_pages[(b * XLAT_TABLE_ENTRIES) + i].region >= 0) {
+				used = true;
+				break;
+			}
+		}
+
+		if (!used)
+			continue;
+
+		uintptr_t va = FUZZ_BASE_VA + (b * XLAT_BLOCK_SIZE(2U));
+
+		l2_used[(va >= UL(0x80000000)) ? 1 : 0] = true;
+
+		if (!fuzz_block_mapped(b))
+			tables++;
+	}
+
+	return tables + (l2_used[0] ? 1U : 0U) + (l2_used[1] ? 1U : 0U);
+}
+
+/*
+ * Translation table walk done independently of the library. Returns the
+ * block or page descriptor that maps va, or INVALID_DESC.
+ */
+static uint64_t fuzz_walk(const xlat_ctx_t *ctx, uintptr_t va,
+			  unsigned int *level)
+{
+	const uint64_t *table = ctx->base_table;
+
+	for (unsigned int l = ctx->base_level; l <= XLAT_TABLE_LEVEL_MAX; l++) {
+		uint64_t desc = table[XLAT_TABLE_IDX(va, l)];
+
+		*level = l;
+
+		if ((desc & DESC_MASK) == INVALID_DESC)
+			return INVALID_DESC;
+
+		if ((l == XLAT_TABLE_LEVEL_MAX) ||
+		    ((desc & DESC_MASK) == BLOCK_DESC))
+			return desc;
+
+		table = (const uint64_t *)(uintptr_t)(desc & TABLE_ADDR_MASK);
+	}
+
+	return INVALID_DESC;
+}
+
+/* Check every page of the window against the reference model. */
+static void fuzz_check(const xlat_ctx_t *ctx)
+{
+	uint64_t attr_mask = ~(TABLE_ADDR_MASK | UPPER_ATTRS(CONT_HINT));
+	unsigned int used_tables = 0U;
+
+	for (unsigned int i = 0U; i < FUZZ_PAGES; i++) {
+		uintptr_t va = FUZZ_BASE_VA + (i * PAGE_SIZE);
+		unsigned int level = 0U;
+		uint64_t desc = fuzz_walk(ctx, va, &level);
+		uint32_t attr;
+		uint64_t start = fuzz_now_ns();
+		int ret = xlat_get_mem_attributes_ctx(ctx, va, &attr);
+
+		fuzz_op_account(FUZZ_OP_LOOKUP, start, ret);
+
+		if (fuzz_pages[i].region < 0) {
+			CHECK(desc == INVALID_DESC);
+			CHECK(ret == -EINVAL);
+			continue;
+		}
+
+		const mmap_region_t *mm = &fuzz_regions[fuzz_pages[i].region].mm;
+		unsigned long long pa = mm->base_pa + (va - mm->base_va);
+		uint64_t expected = xlat_desc(ctx, fuzz_pages[i].attr, 0ULL,
+					      level);
+
+		CHECK(desc != INVALID_DESC);
+		CHECK(XLAT_BLOCK_SIZE(level) <= mm->granularity);
+		CHECK((level == XLAT_TABLE_LEVEL_MAX) ==
+		      !fuzz_block_mapped(i / XLAT_TABLE_ENTRIES));
+		CHECK(((desc & TABLE_ADDR_MASK) +
+		       (va & (XLAT_BLOCK_SIZE(level) - 1U))) == pa);
+		CHECK((desc & attr_mask) == (expected & attr_mask));
+
+		/* The library lookup finds the same descriptor */
+		CHECK(ret == 0);
+		CHECK((xlat_desc(ctx, attr, 0ULL, level) & attr_mask) ==
+		      (desc & attr_mask));
+	}
+
+	for (int i = 0; i < ctx->tables_num; i++) {
+		if (ctx->tables_mapped_regions[i] != 0)
+			used_tables++;
+	}
+
+	/* The library uses the minimum number of tables */
+	CHECK(used_tables == fuzz_expected_tables());
+
+	check_contig_hints(ctx->base_table, ctx->base_table_entries,
+			   ctx->base_level);
+	check_tables_accounting(ctx);
+}
+
+static void fuzz_random_region(mmap_region_t *mm)
+{
+	static const uint32_t attrs[] = {
+		MT_MEMORY | MT_RW | MT_SECURE,
+		MT_MEMORY | MT_RW | MT_NS,
+		MT_MEMORY | MT_RO | MT_SECURE,
+		MT_MEMORY | MT_RO | MT_EXECUTE_NEVER | MT_SECURE,
+		MT_NON_CACHEABLE | MT_RW | MT_SECURE,
+		MT_DEVICE | MT_RW | MT_SECURE,
+	};
+	static const size_t granularities[] = {
+		PAGE_SIZE, XLAT_BLOCK_SIZE(2U), XLAT_BLOCK_SIZE(1U),
+	};
+	unsigned int kind = test_rand_range(4U);
+	size_t pages;
+	uintptr_t va;
+
+	if (kind == 0U)
+		pages = test_rand_range(16U) + 1U;
+	else if (kind == 1U)
+		pages = test_rand_range(2U * XLAT_TABLE_ENTRIES) + 1U;
+	else
+		pages = (test_rand_range(2U) + 1U) * XLAT_TABLE_ENTRIES;
+
+	va = FUZZ_BASE_VA +
+	     (test_rand_range(FUZZ_PAGES - pages + 1U) * PAGE_SIZE);
+	if (kind >= 2U)
+		va = round_down(va, XLAT_BLOCK_SIZE(2U));
+
+	mm->base_va = va;
+	mm->size = pages * PAGE_SIZE;
+	mm->attr = attrs[test_rand_range(ARRAY_SIZE(attrs))];
+	mm->granularity = granularities[test_rand_range(
+						ARRAY_SIZE(granularities))];
+
+	if (test_rand_range(2U) == 0U) {
+		mm->base_pa = va;
+	} else {
+		/* Keep the alignment of the VA most of the time */
+		mm->base_pa = FUZZ_PA_BASE +
+			      (test_rand_range(256U) * XLAT_BLOCK_SIZE(2U));
+		if (test_rand_range(4U) == 0U)
+			mm->base_pa += test_rand_range(XLAT_TABLE_ENTRIES) *
+				       PAGE_SIZE;
+		else
+			mm->base_pa += va & (XLAT_BLOCK_SIZE(2U) - 1U);
+	}
+}
+
+static void fuzz_model_map(unsigned int r, bool map)
+{
+	const mmap_region_t *mm = &fuzz_regions[r].mm;
+	unsigned int first = fuzz_page_idx(mm->base_va);
+
+	for (unsigned int i = 0U; i < (mm->size / PAGE_SIZE); i++) {
+		fuzz_pages[first + i].region = map ? (int)r : -1;
+		fuzz_pages[first + i].attr = mm->attr;
+	}
+}
+
+static void fuzz_add(xlat_ctx_t *ctx)
+{
+	mmap_region_t mm;
+	int expected = 0;
+
+	if (fuzz_regions_num == FUZZ_MAX_REGIONS)
+		return;
+
+	fuzz_random_region(&mm);
+
+	/* Dynamic regions can't overlap any other region */
+	for (unsigned int i = 0U; i < fuzz_regions_num; i++) {
+		const mmap_region_t *r = &fuzz_regions[i].mm;
+
+		if (fuzz_ranges_overlap(mm.base_va, mm.size,
+					r->base_va, r->size) ||
+		    fuzz_ranges_overlap(mm.base_pa, mm.size,
+					r->base_pa, r->size))
+			expected = -EPERM;
+	}
+
+	uint64_t start = fuzz_now_ns();
+	int ret = mmap_add_dynamic_region_ctx(ctx, &mm);
+
+	fuzz_op_account(FUZZ_OP_ADD, start, ret);
+
+	CHECK(ret == expected);
+	if (ret != 0)
+		return;
+
+	fuzz_regions[fuzz_regions_num].mm = mm;
+	fuzz_regions[fuzz_regions_num].is_static = false;
+	fuzz_model_map(fuzz_regions_num, true);
+	fuzz_regions_num++;
+}
+
+static void fuzz_remove(xlat_ctx_t *ctx)
+{
+	if (fuzz_regions_num == 0U)
+		return;
+
+	unsigned int r = test_rand_range(fuzz_regions_num);
+	const mmap_region_t *mm = &fuzz_regions[r].mm;
+	bool bogus = test_rand_range(8U) == 0U;
+	size_t size = bogus ? (mm->size + PAGE_SIZE) : mm->size;
+	int expected = bogus ? -EINVAL :
+		       (fuzz_regions[r].is_static ? -EPERM : 0);
+
+	uint64_t start = fuzz_now_ns();
+	int ret = mmap_remove_dynamic_region_ctx(ctx, mm->base_va, size);
+
+	fuzz_op_account(FUZZ_OP_REMOVE, start, ret);
+
+	CHECK(ret == expected);
+	if (ret != 0)
+		return;
+
+	fuzz_model_map(r, false);
+
+	/* Move the last region to the free slot, keeping its attributes */
+	fuzz_regions_num--;
+	if (r != fuzz_regions_num) {
+		fuzz_regions[r] = fuzz_regions[fuzz_regions_num];
+		for (unsigned int i = 0U; i < FUZZ_PAGES; i++) {
+			if (fuzz_pages[i].region == (int)fuzz_regions_num)
+				fuzz_pages[i].region = (int)r;
+		}
+	}
+}
+
+static void fuzz_change(xlat_ctx_t *ctx)
+{
+	static const uint32_t attrs[] = {
+		MT_RO, MT_RO | MT_EXECUTE_NEVER, MT_RW | MT_EXECUTE_NEVER,
+		MT_RW,
+	};
+	uint32_t attr = attrs[test_rand_range(ARRAY_SIZE(attrs))];
+	unsigned int first, count;
+	int expected = 0;
+
+	if ((fuzz_regions_num != 0U) && (test_rand_range(4U) != 0U)) {
+		/* Pages of a region, sometimes past its end */
+		const mmap_region_t *mm =
+			&fuzz_regions[test_rand_range(fuzz_regions_num)].mm;
+		unsigned int pages = (unsigned int)(mm->size / PAGE_SIZE);
+
+		first = fuzz_page_idx(mm->base_va) + test_rand_range(pages);
+		count = test_rand_range(pages) + 1U;
+	} else {
+		first = test_rand_range(FUZZ_PAGES);
+		count = test_rand_range(64U) + 1U;
+	}
+
+	if ((first + count) > FUZZ_PAGES)
+		count = FUZZ_PAGES - first;
+
+	if (((attr & MT_RW) != 0U) && ((attr & MT_EXECUTE_NEVER) == 0U))
+		expected = -EINVAL;
+
+	for (unsigned int i = first; i < (first + count); i++) {
+		if ((fuzz_pages[i].region < 0) ||
+		    fuzz_block_mapped(i / XLAT_TABLE_ENTRIES))
+			expected = -EINVAL;
+		else if ((MT_TYPE(fuzz_pages[i].attr) == MT_DEVICE) &&
+			 ((attr & MT_EXECUTE_NEVER) == 0U))
+			expected = -EINVAL;
+	}
+
+	uint64_t start = fuzz_now_ns();
+	int ret = xlat_change_mem_attributes_ctx(ctx,
+			FUZZ_BASE_VA + (first * PAGE_SIZE),
+			count * PAGE_SIZE, attr);
+
+	fuzz_op_account(FUZZ_OP_CHANGE, start, ret);
+
+	CHECK(ret == expected);
+	if (ret != 0)
+		return;
+
+	for (unsigned int i = first; i < (first + count); i++) {
+		uint32_t mask = MT_RW | MT_EXECUTE_NEVER | MT_USER;
+
+		fuzz_pages[i].attr = (fuzz_pages[i].attr & ~mask) |
+				     (attr & mask);
+	}
+}
+
+/*
+ * Run random sequences of additions and removals of dynamic regions and of
+ * attribute changes, and check the translation tables against a reference
+ * model of the mapped pages after each operation.
+ */
+static void test_fuzz(void)
+{
+	xlat_ctx_t *ctx = &fuzz_xlat_ctx;
+	mmap_region_t mm = MAP_REGION2(UL(0x80000000), UL(0x80000000),
+				       16U * PAGE_SIZE,
+				       MT_MEMORY | MT_RW | MT_SECURE,
+				       PAGE_SIZE);
+
+	for (unsigned int i = 0U; i < FUZZ_PAGES; i++)
+		fuzz_pages[i].region = -1;
+
+	mmap_add_region_ctx(ctx, &mm);
+	init_xlat_tables_ctx(ctx);
+
+	fuzz_regions[0].mm = ctx->mmap[0];
+	fuzz_regions[0].is_static = true;
+	fuzz_regions_num = 1U;
+	fuzz_model_map(0U, true);
+	fuzz_check(ctx);
+
+	for (unsigned int i = 0U; i < FUZZ_ITERATIONS; i++) {
+		unsigned int op = test_rand_range(8U);
+
+		if (op < 3U)
+			fuzz_add(ctx);
+		else if (op < 5U)
+			fuzz_remove(ctx);
+		else
+			fuzz_change(ctx);
+
+		fuzz_check(ctx);
+	}
+
+	printf("  %-20s %10s %10s %10s %10s\n", "operation", "count",
+	       "errors", "avg (ns)", "max (ns)");
+	for (unsigned int op = 0U; op < FUZZ_OP_NUM; op++) {
+		unsigned long count = fuzz_op_stats[op].count;
+
+		printf("  %-20s %10lu %10lu %10llu %10llu\n", fuzz_op_names[op],
+		       count, fuzz_op_stats[op].errors, (count == 0UL) ? 0ULL :
+		       (unsigned long long)(fuzz_op_stats[op].total_ns / count),
+		       (unsigned long long)fuzz_op_stats[op].max_ns);
+	}
+}
+
+static const struct {
+	const char *name;
+	void (*func)(void);
+} tests[] = {
+	{ "change_attributes", test_change_attributes },
+	{ "dynamic_stress", test_dynamic_stress },
+	{ "dynamic_exhaust", test_dynamic_exhaust },
+	{ "fuzz", test_fuzz },
+};
+
+int main(int argc, char *argv[])
+{
+	unsigned int failed = 0U;
+
+	if (argc > 2) {
+		fprintf(stderr, "Usage: %s [seed]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	/* The state of the generator must not be 0 */
+	if (argc == 2)
+		test_rand_state = strtoull(argv[1], NULL, 0) | 1ULL;
+
+	printf("Seed: 0x%llx\n", (unsigned long long)test_rand_state);
+
+	for (unsigned int i = 0U; i < ARRAY_SIZE(tests); i++) {
+		unsigned int failures = test_failures;
+
+		tests[i].func();
+
+		if (test_failures != failures) {
+			printf("FAIL: %s\n", tests[i].name);
+			failed++;
+		} else {
+			printf("PASS: %s\n", tests[i].name);
+		}
+	}
+
+	printf("%zu/%zu tests passed\n", ARRAY_SIZE(tests) - failed,
+	       ARRAY_SIZE(tests));
+
+	return (failed == 0U) ? EXIT_SUCCESS : EXIT_FAILURE;
+}